@@ -4,6 +4,9 @@ import os
 from os.path import join, exists
 import argparse
 
+# The random opcodes and the name of their function, which we handle separately
+RANDOM_FUNCS = {"BH_RANDOM": "random", "BH_RANDOM_NORMAL": "random_normal"}
+
 def main(args):
     prefix = os.path.abspath(os.path.dirname(__file__))
 
@@ -14,7 +17,9 @@ def main(args):
     with open(join(prefix, '..', '..', 'core', 'codegen', 'types.json')) as f:
         types   = json.loads(f.read())
         type_map = {}
-        for t in types[:-1]:
+        for t in types:
+            if t['enum'] == "BH_R123":
+                continue
             type_map[t['enum']] = {
                 'cpp'     : t['cpp'],
                 'bhc'     : t['bhc'],
@@ -26,7 +31,7 @@ def main(args):
     head = ""; impl = ""
     for op in opcodes:
         # We handle random separately and ignore None
-        if op['opcode'] in ["BH_RANDOM", "BH_NONE", "BH_TALLY"]:
+        if op['opcode'] in list(RANDOM_FUNCS.keys()) + ["BH_NONE", "BH_TALLY"]:
             continue
 
         doc = "// %s: %s\n" % (op['opcode'][3:], op['doc'])
@@ -75,6 +80,8 @@ def main(args):
                         if t.startswith("BH_COMPLEX"):
                             impl += "\ti%(i)d.real(in%(i)d.real);\n" % {'i': i+1}
                             impl += "\ti%(i)d.imag(in%(i)d.imag);\n" % {'i': i+1}
+                        elif t in ["BH_FLOAT16", "BH_BFLOAT16"]:
+                            impl += "\ti%(i)d.bits = in%(i)d;\n" % {'i': i+1}
                         else:
                             impl += "\ti%(i)d = in%(i)d;\n" % {'i': i+1}
                         bxx_args += ", i%d" % (i+1);
@@ -93,17 +100,26 @@ def main(args):
 
   random123(out, seed, key) where: 'out' is the array to fill with random data
                                    'seed' is the seed of a random sequence
-                                   'key' is the index in the random sequence */
+                                   'key' is the index in the random sequence
+
+  A float32/float64 'out' is filled with uniform numbers in [0, 1) and
+  random123_normal() fills 'out' with standard normal numbers */
 """
     impl += doc; head += doc
-    decl = "void bhc_random123_Auint64_Kuint64_Kuint64(bhc_ndarray_uint64_p out, uint64_t seed, uint64_t key)"
-    head += "DLLEXPORT %s;\n" % decl
-    impl += "%s\n" % decl
-    impl += """
+    for op in opcodes:
+        if op['opcode'] not in RANDOM_FUNCS:
+            continue
+        for type_sig in op['types']:
+            t = type_map[type_sig[0]]
+            decl = "void bhc_%s_A%s_Kuint64_Kuint64(%s out, uint64_t seed, uint64_t key)" % \
+                   (RANDOM_FUNCS[op['opcode']].replace("random", "random123"), t['name'], t['bhc_ary'])
+            head += "DLLEXPORT %s;\n" % decl
+            impl += "%s\n" % decl
+            impl += """
 {
-    bhxx::random(*((bhxx::BhArray<uint64_t>*) out), seed, key);
+    bhxx::%s(*((bhxx::BhArray<%s>*) out), seed, key);
 }
-"""
+""" % (RANDOM_FUNCS[op['opcode']], t['cpp'])
 
     #Let's add header and footer
     head = """/* Bohrium C Bridge: array operation functions. Auto generated! */
@@ -11,7 +11,9 @@ def main(args):
     with open(join(prefix, '..', '..', 'core', 'codegen', 'types.json')) as f:
         types   = json.loads(f.read())
         type_map = {}
-        for t in types[:-1]:
+        for t in types:
+            if t['enum'] == "BH_R123":
+                continue
             type_map[t['enum']] = {
                 'cpp'     : t['cpp'],
                 'bhc'     : t['bhc'],
@@ -205,10 +207,21 @@ def main(args):
 
     doc = "\n// Extension Method, returns 0 when the extension exist\n"
     impl += doc; head += doc
-    for key, t in type_map.items():
+    # All operands have the same type except for the compactions, which takes a boolean mask as the last
+    # input ("compact") or returns the indices of a boolean mask ("flatnonzero"), "argsort", which
+    # returns int64 indices, and "spmv_csr", which takes the int64 `indptr` and `indices` of a sparse matrix
+    signatures = [(t, t, t) for t in type_map.values()]
+    signatures += [(t, t, type_map['BH_BOOL']) for key, t in type_map.items() if key != 'BH_BOOL']
+    signatures += [(type_map['BH_UINT64'], type_map['BH_BOOL'], type_map['BH_BOOL'])]
+    signatures += [(type_map['BH_INT64'], t, t) for key, t in type_map.items() if key != 'BH_INT64']
+    signatures += [(t, type_map['BH_INT64'], type_map['BH_INT64'], t, t) for key, t in type_map.items()
+                   if key != 'BH_BOOL']
+    for signature in signatures:
+        names = ["out"] + ["in%d" % i for i in range(1, len(signature))]
         decl = "int bhc_extmethod"
-        decl += "_A%(name)s_A%(name)s_A%(name)s" % t
-        decl += "(const char *name, %(bhc_ary)s out, const %(bhc_ary)s in1, const %(bhc_ary)s in2)" % t
+        decl += "".join("_A%s" % t['name'] for t in signature)
+        decl += "(const char *name, %s out, " % signature[0]['bhc_ary']
+        decl += ", ".join("const %s %s" % (t['bhc_ary'], n) for t, n in zip(signature[1:], names[1:])) + ")"
         head += "DLLEXPORT %s;\n" % decl
         impl += "%s" % decl
         impl += """
@@ -216,9 +229,7 @@ def main(args):
     try {
         bhxx::Runtime::instance().enqueueExtmethod(
             name,
-            *((bhxx::BhArray<%(cpp)s>*) out),
-            *((bhxx::BhArray<%(cpp)s>*) in1),
-            *((bhxx::BhArray<%(cpp)s>*) in2)
+%s
         );
     } catch (...) {
         return -1;
@@ -226,7 +237,7 @@ def main(args):
     return 0;
 }
 
-""" % t
+""" % ",\n".join("            *((bhxx::BhArray<%s>*) %s)" % (t['cpp'], n) for t, n in zip(signature, names))
 
     #Let's add header and footer
     head = """/* Bohrium C Bridge: special functions. Auto generated! */
@@ -11,7 +11,9 @@ def main(args):
     with open(join(prefix, '..', '..', 'core', 'codegen', 'types.json')) as f:
         types    = json.loads(f.read())
         type_map = {}
-        for t in types[:-1]:
+        for t in types:
+            if t['enum'] == "BH_R123":
+                continue
             type_map[t['enum']] = {
                 'cpp'     : t['cpp'],
                 'bhc'     : t['bhc'],
@@ -52,6 +54,8 @@ typedef double        bhc_float64;
 typedef struct { bhc_float32 real, imag; } bhc_complex64;
 typedef struct { bhc_float64 real, imag; } bhc_complex128;
 typedef struct { bhc_uint64 start, key; } bhc_r123;
+typedef uint16_t      bhc_float16;  // The bit pattern of an IEEE 754 half precision float
+typedef uint16_t      bhc_bfloat16; // The upper 16 bits of an IEEE 754 single precision float
 
 #ifdef _WIN32
 #define DLLEXPORT __declspec( dllexport )
@@ -0,0 +1,137 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <bhxx/bhxx.hpp>
+
+// Benchmark of the sparse matrix-vector multiplication on a banded and a power-law matrix.
+// Usage: bhxx_spmv [number of rows] [number of repeats]
+
+using bhxx::BhArray;
+using bhxx::Runtime;
+
+// A sparse matrix in the CSR format
+struct Csr {
+    std::vector<int64_t> indptr, indices;
+    std::vector<double> data;
+};
+
+// A matrix where each row has the nonzeros of the `width` columns around the diagonal
+Csr banded(int64_t nrows, int64_t width, std::mt19937 &gen) {
+    std::uniform_real_distribution<double> value(-1, 1);
+    Csr ret;
+    ret.indptr.push_back(0);
+    for (int64_t r = 0; r < nrows; ++r) {
+        for (int64_t c = std::max<int64_t>(0, r - width / 2); c < std::min(nrows, r + width / 2 + 1); ++c) {
+            ret.indices.push_back(c);
+            ret.data.push_back(value(gen));
+        }
+        ret.indptr.push_back(ret.indices.size());
+    }
+    return ret;
+}
+
+// A matrix where the number of nonzeros in a row follows a power-law distribution with exponent `alpha`,
+// like the adjacency matrix of a social network graph
+Csr power_law(int64_t nrows, double alpha, std::mt19937 &gen) {
+    std::uniform_real_distribution<double> value(-1, 1), uniform(0, 1);
+    std::uniform_int_distribution<int64_t> column(0, nrows - 1);
+    Csr ret;
+    ret.indptr.push_back(0);
+    for (int64_t r = 0; r < nrows; ++r) {
+        const double degree = std::pow(1.0 - uniform(gen), -1.0 / (alpha - 1.0));
+        const int64_t nnz = std::min<int64_t>(nrows, static_cast<int64_t>(degree));
+        for (int64_t i = 0; i < nnz; ++i) {
+            ret.indices.push_back(column(gen));
+            ret.data.push_back(value(gen));
+        }
+        ret.indptr.push_back(ret.indices.size());
+    }
+    return ret;
+}
+
+template <typename T>
+BhArray<T> to_bhxx(const std::vector<T> &vec) {
+    BhArray<T> ret({vec.size()});
+    T *data = static_cast<T *>(Runtime::instance().getMemoryPointer(ret.base, true, true, false));
+    std::copy(vec.begin(), vec.end(), data);
+    return ret;
+}
+
+void benchmark(const std::string &name, const Csr &mat, int64_t nrepeats, std::mt19937 &gen) {
+    const int64_t nrows = mat.indptr.size() - 1;
+    const int64_t nnz = mat.data.size();
+    std::uniform_real_distribution<double> value(-1, 1);
+    std::vector<double> x_vec(nrows);
+    for (double &v: x_vec) {
+        v = value(gen);
+    }
+
+    BhArray<int64_t> indptr = to_bhxx(mat.indptr);
+    BhArray<int64_t> indices = to_bhxx(mat.indices);
+    BhArray<double> data = to_bhxx(mat.data);
+    BhArray<double> x = to_bhxx(x_vec);
+
+    double seconds = 0;
+    BhArray<double> y({static_cast<uint64_t>(nrows)});
+    for (int64_t i = 0; i <= nrepeats; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        y = bhxx::spmv_csr(indptr, indices, data, x);
+        Runtime::instance().sync(y.base);
+        Runtime::instance().flush();
+        if (i > 0) { // The first iteration is a warm up
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    // Check the result against a sequential multiplication
+    const double *y_data = static_cast<double *>(Runtime::instance().getMemoryPointer(y.base, true, false, false));
+    double max_error = 0;
+    for (int64_t r = 0; r < nrows; ++r) {
+        double sum = 0;
+        for (int64_t k = mat.indptr[r]; k < mat.indptr[r + 1]; ++k) {
+            sum += mat.data[k] * x_vec[mat.indices[k]];
+        }
+        max_error = std::max(max_error, std::abs(sum - y_data[r]) / (1 + std::abs(sum)));
+    }
+
+    int64_t longest_row = 0;
+    for (int64_t r = 0; r < nrows; ++r) {
+        longest_row = std::max(longest_row, mat.indptr[r + 1] - mat.indptr[r]);
+    }
+    std::cout << name << ": " << nrows << " rows, " << nnz << " nonzeros (longest row " << longest_row << "), "
+              << seconds / nrepeats * 1e3 << " ms per spmv, "
+              << 2.0 * nnz * nrepeats / seconds * 1e-9 << " GFLOP/s, max error " << max_error << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    const int64_t nrows = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    const int64_t nrepeats = argc > 2 ? std::atoll(argv[2]) : 10;
+    std::mt19937 gen(42);
+    benchmark("banded", banded(nrows, 27, gen), nrepeats, gen);
+    benchmark("power-law", power_law(nrows, 2.1, gen), nrepeats, gen);
+    return 0;
+}
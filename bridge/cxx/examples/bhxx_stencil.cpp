@@ -0,0 +1,104 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <bhxx/bhxx.hpp>
+
+// Benchmark of a 4-D Laplace stencil, which fuses into one kernel of nine views of the same array.
+// Toggle `offset_as_var` in the config to compare the generated index arithmetic.
+// Usage: bhxx_stencil [grid size] [number of repeats]
+
+using bhxx::BhArray;
+using bhxx::Runtime;
+
+constexpr int NDIM = 4;
+
+int main(int argc, char *argv[]) {
+    const uint64_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 40;
+    const int64_t nrepeats = argc > 2 ? std::atoll(argv[2]) : 10;
+    const uint64_t m = n - 2;
+    const uint64_t size = n * n * n * n;
+    const int64_t stride[NDIM] = {static_cast<int64_t>(n * n * n), static_cast<int64_t>(n * n),
+                                  static_cast<int64_t>(n), 1};
+
+    BhArray<double> grid({n, n, n, n});
+    double *grid_data = static_cast<double *>(Runtime::instance().getMemoryPointer(grid.base, true, true, false));
+    for (uint64_t i = 0; i < size; ++i) {
+        grid_data[i] = std::sin(static_cast<double>(i));
+    }
+
+    // The interior of `grid` shifted by `shift` along each axis
+    auto interior = [&](const int shift[NDIM]) {
+        BhArray<double> ret = grid;
+        ret.offset = 0;
+        for (int d = 0; d < NDIM; ++d) {
+            ret.offset += (1 + shift[d]) * stride[d];
+        }
+        ret.shape = {m, m, m, m};
+        return ret;
+    };
+
+    double seconds = 0;
+    BhArray<double> res({m, m, m, m});
+    for (int64_t i = 0; i <= nrepeats; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        const int center[NDIM] = {0, 0, 0, 0};
+        bhxx::multiply(res, interior(center), -2.0 * NDIM);
+        for (int d = 0; d < NDIM; ++d) {
+            for (int s: {-1, 1}) {
+                int shift[NDIM] = {0, 0, 0, 0};
+                shift[d] = s;
+                bhxx::add(res, res, interior(shift));
+            }
+        }
+        Runtime::instance().sync(res.base);
+        Runtime::instance().flush();
+        if (i > 0) { // The first iteration is a warm up
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+
+    // Check the result against a sequential stencil
+    const double *res_data = static_cast<double *>(Runtime::instance().getMemoryPointer(res.base, true, false,
+                                                                                         false));
+    double max_error = 0;
+    for (uint64_t i = 0; i < m * m * m * m; ++i) {
+        int64_t offset = 0;
+        uint64_t idx = i;
+        for (int d = NDIM - 1; d >= 0; --d) {
+            offset += static_cast<int64_t>(idx % m + 1) * stride[d];
+            idx /= m;
+        }
+        double expect = -2.0 * NDIM * grid_data[offset];
+        for (int d = 0; d < NDIM; ++d) {
+            expect += grid_data[offset - stride[d]] + grid_data[offset + stride[d]];
+        }
+        max_error = std::max(max_error, std::abs(expect - res_data[i]));
+    }
+    std::cout << "stencil: " << n << "^" << NDIM << " grid, " << seconds / nrepeats * 1e3 << " ms per sweep, "
+              << 9.0 * m * m * m * m * nrepeats / seconds * 1e-9 << " GFLOP/s, max error " << max_error
+              << std::endl;
+    return 0;
+}
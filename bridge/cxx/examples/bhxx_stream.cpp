@@ -0,0 +1,96 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <limits>
+
+#include <bhxx/bhxx.hpp>
+
+// STREAM-like benchmark of kernels that overwrite a large output array, which the OpenMP backend writes with
+// non-temporal stores when the array exceeds `streaming_store_threshold`. Toggle the threshold in the config to
+// compare the bandwidth of the streaming stores to the regular stores.
+// Usage: bhxx_stream [number of elements] [number of repeats]
+
+using bhxx::BhArray;
+using bhxx::Runtime;
+
+int main(int argc, char *argv[]) {
+    const uint64_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1u << 25;
+    const int64_t nrepeats = argc > 2 ? std::atoll(argv[2]) : 10;
+    const double scalar = 3.0;
+
+    BhArray<double> a({n}), b({n}), c({n});
+    bhxx::identity(a, 1.0);
+    bhxx::identity(b, 2.0);
+    bhxx::identity(c, 0.0);
+    Runtime::instance().flush();
+
+    // Runs `kernel` `nrepeats` times after a warm up and returns the best bandwidth in GB/s, where `narrays` is the
+    // number of arrays the kernel reads or writes (as in STREAM, the read-for-ownership traffic isn't counted)
+    auto bandwidth = [&](int narrays, const std::function<void()> &kernel) {
+        double best = std::numeric_limits<double>::max();
+        for (int64_t i = 0; i <= nrepeats; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            kernel();
+            Runtime::instance().flush();
+            if (i > 0) { // The first iteration is a warm up
+                best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+            }
+        }
+        return narrays * sizeof(double) * n / best * 1e-9;
+    };
+
+    const double fill = bandwidth(1, [&] { bhxx::identity(c, 0.0); });
+    const double arange = bandwidth(1, [&] {
+        BhArray<uint64_t> idx({n});
+        bhxx::range(idx);
+        bhxx::identity(c, idx);
+    });
+    const double copy = bandwidth(2, [&] { bhxx::identity(c, a); });
+    const double scale = bandwidth(2, [&] { bhxx::multiply(b, c, scalar); });
+    const double add = bandwidth(3, [&] { bhxx::add(c, a, b); });
+    const double triad = bandwidth(3, [&] {
+        bhxx::multiply(a, c, scalar);
+        bhxx::add(a, a, b);
+    });
+
+    // Every kernel overwrites its output, so the final values follow the STREAM recurrence from `a = 1`
+    const double expect_b = scalar * 1.0;
+    const double expect_c = 1.0 + expect_b;
+    const double expect_a = expect_b + scalar * expect_c;
+
+    const double *a_data = static_cast<double *>(Runtime::instance().getMemoryPointer(a.base, true, false, false));
+    const double *b_data = static_cast<double *>(Runtime::instance().getMemoryPointer(b.base, true, false, false));
+    const double *c_data = static_cast<double *>(Runtime::instance().getMemoryPointer(c.base, true, false, false));
+    double max_error = 0;
+    for (uint64_t i = 0; i < n; ++i) {
+        max_error = std::max(max_error, std::abs(a_data[i] - expect_a));
+        max_error = std::max(max_error, std::abs(b_data[i] - expect_b));
+        max_error = std::max(max_error, std::abs(c_data[i] - expect_c));
+    }
+    std::cout << "stream: " << n << " elements, fill " << fill << " GB/s, arange " << arange << " GB/s, copy "
+              << copy << " GB/s, scale " << scale << " GB/s, add " << add << " GB/s, triad " << triad
+              << " GB/s, max error " << max_error << std::endl;
+    return 0;
+}
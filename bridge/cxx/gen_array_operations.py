@@ -4,6 +4,9 @@ import os
 from os.path import join, exists
 import argparse
 
+# The random opcodes and the name of their function, which we handle separately
+RANDOM_FUNCS = {"BH_RANDOM": "random", "BH_RANDOM_NORMAL": "random_normal"}
+
 def main(args):
     prefix = os.path.abspath(os.path.dirname(__file__))
 
@@ -13,7 +16,9 @@ def main(args):
     with open(join(prefix, '..', '..', 'core', 'codegen', 'types.json')) as f:
         types   = json.loads(f.read())
         type_map = {}
-        for t in types[:-1]:
+        for t in types:
+            if t['enum'] == "BH_R123":
+                continue
             type_map[t['enum']] = {
                 'cpp'     : t['cpp'],
                 'bhc'     : t['bhc'],
@@ -24,7 +29,7 @@ def main(args):
     # Let's generate the header and implementation of all array operations
     head = ""; impl = ""
     for op in opcodes:
-        if op['opcode'] in ["BH_RANDOM"]:
+        if op['opcode'] in RANDOM_FUNCS:
             continue
         # Generate functions that takes no operands
         if len(op['types']) == 0:
@@ -64,19 +69,27 @@ def main(args):
   of values produced by simply incrementing the counter (or key) is effectively
   indistinguishable from a sequence of samples of a uniformly distributed random variable.
 
-  random123(out, seed, key) where: 'out' is the array to fill with random data
-                                   'seed' is the seed of a random sequence
-                                   'key' is the index in the random sequence */
+  random(out, seed, key) where: 'out' is the array to fill with random data
+                                'seed' is the seed of a random sequence
+                                'key' is the index in the random sequence
+
+  A float32/float64 'out' is filled with uniform numbers in [0, 1) and
+  random_normal() fills 'out' with standard normal numbers */
 """
     impl += doc; head += doc
-    decl = "void random(BhArray<uint64_t> &out, uint64_t seed, uint64_t key)"
-    head += "%s;\n" % decl
-    impl += "%s\n" % decl
-    impl += """
+    for op in opcodes:
+        if op['opcode'] not in RANDOM_FUNCS:
+            continue
+        for type_sig in op['types']:
+            decl = "void %s(BhArray<%s> &out, uint64_t seed, uint64_t key)" % (RANDOM_FUNCS[op['opcode']],
+                                                                              type_map[type_sig[0]]['cpp'])
+            head += "%s;\n" % decl
+            impl += "%s\n" % decl
+            impl += """
 {
-    \tRuntime::instance().enqueueRandom(out, seed, key);
+    \tRuntime::instance().enqueueRandom(%s, out, seed, key);
 }
-"""
+""" % op['opcode']
 
     # Let's add header and footer
     head = """/* Bohrium CXX Bridge: array operation functions. Auto generated! */
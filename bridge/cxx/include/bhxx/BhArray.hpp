@@ -64,7 +64,7 @@ class BhArray {
           : offset(offset_),
             shape(shape_),
             stride(std::move(stride_)),
-            base(make_base_ptr(T(0), shape_.prod())) {
+            base(make_base_ptr(T(), shape_.prod())) {
         assert(shape.size() == stride.size());
         assert(shape.prod() > 0);
     }
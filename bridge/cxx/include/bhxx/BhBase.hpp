@@ -62,7 +62,7 @@ public:
      */
     template <typename InputIterator, typename T = typename std::iterator_traits<InputIterator>::value_type>
     BhBase(InputIterator begin, InputIterator end)
-          : BhBase(T(0), static_cast<size_t>(std::distance(begin, end))) {
+          : BhBase(T(), static_cast<size_t>(std::distance(begin, end))) {
         assert(std::distance(begin, end) > 0);
 
         // Allocate an array and copy the data over.
@@ -73,8 +73,8 @@ public:
     /** Construct a base array with nelem elements
      *
      * \param dummy   Dummy argument to fix the type of elements used.
-     *                It may only have ever have the value 0 in the
-     *                appropriate type.
+     *                It should be the value-initialised T(), which is
+     *                zero for the arithmetic types.
      *
      * \note The use of this particular constructor is discouraged.
      *       It is only needed from BhArray to construct base objects
@@ -89,8 +89,8 @@ public:
         nelem = nelem_;
         set_type<T>();
 
-        // The dummy is a dummy argument and should always be identical zero.
-        assert(dummy == T(0));
+        // The dummy is a dummy argument that only fixes the type
+        static_cast<void>(dummy);
     }
 
     ~BhBase() {
@@ -59,13 +59,13 @@ class Runtime {
     /** Enqueue any BhInstruction object */
     void enqueue(BhInstruction instr);
 
-    // We have to handle random specially because of the `BH_R123` scalar type
-    void enqueueRandom(BhArray<uint64_t>& out, uint64_t seed, uint64_t key);
-
-    // Enqueue an extension method
+    // We have to handle random (BH_RANDOM and BH_RANDOM_NORMAL) specially because of the `BH_R123` scalar type
     template <typename T>
-    void enqueueExtmethod(const std::string& name, BhArray<T>& out, BhArray<T>& in1,
-                          BhArray<T>& in2);
+    void enqueueRandom(bh_opcode opcode, BhArray<T>& out, uint64_t seed, uint64_t key);
+
+    // Enqueue an extension method, which takes an output and one or more inputs
+    template <typename TO, typename T, typename... Ts>
+    void enqueueExtmethod(const std::string& name, BhArray<TO>& out, BhArray<T>& in, BhArray<Ts>&... ins);
 
     /** Schedule a base object for deletion
      *
@@ -146,6 +146,9 @@ class Runtime {
     void freeMemory(BhArray<T>& ary);
     //@}
 
+    // Get the opcode of the extension method `name`, which is assigned at first use
+    bh_opcode extmethodOpcode(const std::string& name);
+
     // The lazy evaluated instructions
     std::vector<bh_instruction> instr_list;
 
@@ -190,23 +193,23 @@ void Runtime::enqueue(bh_opcode opcode, T& op, Ts&... ops) {
 }
 
 template <typename T>
-void Runtime::enqueueExtmethod(const std::string& name, BhArray<T>& out, BhArray<T>& in1,
-                               BhArray<T>& in2) {
-    bh_opcode opcode;
-
-    // Look for the extension opcode
-    auto it = extmethods.find(name);
-    if (it != extmethods.end()) {
-        opcode = it->second;
-    } else {
-        // Add it and tell rest of Bohrium about this new extmethod
-        opcode = extmethod_next_opcode_id++;
-        runtime.extmethod(name.c_str(), opcode);
-        extmethods.insert(std::pair<std::string, bh_opcode>(name, opcode));
-    }
+void Runtime::enqueueRandom(bh_opcode opcode, BhArray<T>& out, uint64_t seed, uint64_t key) {
+    BhInstruction instr(opcode);
+    instr.appendOperand(out);  // Append output array
+
+    // Append the special BH_R123 constant
+    bh_constant cnt;
+    cnt.type             = bh_type::R123;
+    cnt.value.r123.start = seed;
+    cnt.value.r123.key   = key;
+    instr.appendOperand(cnt);
+
+    enqueue(std::move(instr));
+}
 
-    // Now that we have an opcode, let's enqueue the instruction
-    enqueue(opcode, out, in1, in2);
+template <typename TO, typename T, typename... Ts>
+void Runtime::enqueueExtmethod(const std::string& name, BhArray<TO>& out, BhArray<T>& in, BhArray<Ts>&... ins) {
+    enqueue(extmethodOpcode(name), out, in, ins...);
 }
 
 template <typename T>
@@ -65,6 +65,15 @@ BhArray<T> reshape(BhArray<T> ary, Shape shape);
 template <typename T>
 BhArray<T> matmul(BhArray<T> lhs, BhArray<T> rhs);
 
+/** Perform a sparse matrix-vector multiplication
+ *
+ * Multiplies the matrix in the CSR format given by `indptr`, `indices`,
+ * and `data` with the vector `x`. The matrix has `indptr.size - 1` rows.
+ * Requires the `spmv_csr` extension method.
+ * */
+template <typename T>
+BhArray<T> spmv_csr(BhArray<int64_t> indptr, BhArray<int64_t> indices, BhArray<T> data, BhArray<T> x);
+
 /** Performs a full reduction of the array along all axis using the
  *  add_reduce operation.
  *
@@ -25,6 +25,14 @@ If not, see <http://www.gnu.org/licenses/>.
 
 using namespace std;
 
+// Print the 16-bit float types in single precision
+static ostream& operator<<(ostream& os, bh_float16 val) {
+    return os << bh_float16_to_float32(val);
+}
+static ostream& operator<<(ostream& os, bh_bfloat16 val) {
+    return os << bh_bfloat16_to_float32(val);
+}
+
 namespace bhxx {
 
 // Note: This one line of code cannot move to the hpp file,
@@ -108,6 +116,8 @@ INSTANTIATE(float);
 INSTANTIATE(double);
 INSTANTIATE(std::complex<float>);
 INSTANTIATE(std::complex<double>);
+INSTANTIATE(bh_float16);
+INSTANTIATE(bh_bfloat16);
 
 #undef INSTANTIATE
 
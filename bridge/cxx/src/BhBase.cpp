@@ -43,6 +43,8 @@ INSTANTIATE(float);
 INSTANTIATE(double);
 INSTANTIATE(std::complex<float>);
 INSTANTIATE(std::complex<double>);
+INSTANTIATE(bh_float16);
+INSTANTIATE(bh_bfloat16);
 
 #undef INSTANTIATE
 }
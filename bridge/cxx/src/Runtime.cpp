@@ -41,18 +41,18 @@ void Runtime::enqueue(BhInstruction instr) {
     }
 }
 
-void Runtime::enqueueRandom(BhArray<uint64_t>& out, uint64_t seed, uint64_t key) {
-    BhInstruction instr(BH_RANDOM);
-    instr.appendOperand(out);  // Append output array
-
-    // Append the special BH_R123 constant
-    bh_constant cnt;
-    cnt.type             = bh_type::R123;
-    cnt.value.r123.start = seed;
-    cnt.value.r123.key   = key;
-    instr.appendOperand(cnt);
+bh_opcode Runtime::extmethodOpcode(const std::string& name) {
+    // Look for the extension opcode
+    auto it = extmethods.find(name);
+    if (it != extmethods.end()) {
+        return it->second;
+    }
 
-    enqueue(std::move(instr));
+    // Add it and tell rest of Bohrium about this new extmethod
+    const bh_opcode opcode = extmethod_next_opcode_id++;
+    runtime.extmethod(name.c_str(), opcode);
+    extmethods.insert(std::pair<std::string, bh_opcode>(name, opcode));
+    return opcode;
 }
 
 void Runtime::enqueueDeletion(std::unique_ptr<BhBase> base_ptr) {
@@ -151,15 +151,33 @@ BhArray<T> matmul(BhArray<T> lhs, BhArray<T> rhs) {
     return reshape(std::move(result), result_shape);
 }
 
+template <typename T>
+BhArray<T> spmv_csr(BhArray<int64_t> indptr, BhArray<int64_t> indices, BhArray<T> data, BhArray<T> x) {
+    if (indptr.rank() != 1 || indices.rank() != 1 || data.rank() != 1 || x.rank() != 1) {
+        throw std::runtime_error("spmv_csr: all arguments need to be of rank 1.");
+    }
+    if (indptr.numberOfElements() == 0) {
+        throw std::runtime_error("spmv_csr: indptr needs at least one element.");
+    }
+    if (indices.numberOfElements() != data.numberOfElements()) {
+        throw std::runtime_error("spmv_csr: indices and data need to have the same size.");
+    }
+
+    BhArray<T> result({indptr.numberOfElements() - 1});
+    Runtime::instance().enqueueExtmethod("spmv_csr", result, indptr, indices, data, x);
+    return result;
+}
+
 // Instantiate all possible types of `BhArray`
 #define INSTANTIATE(T)                         \
     template T          as_scalar(BhArray<T>); \
     template BhArray<T> transpose(BhArray<T>); \
     template BhArray<T> broadcast(BhArray<T>, int64_t, size_t)
 
-#define INSTANTIATE_NOBOOL(T) \
-    INSTANTIATE(T);           \
-    template BhArray<T> matmul(BhArray<T>, BhArray<T>)
+#define INSTANTIATE_NOBOOL(T)                           \
+    INSTANTIATE(T);                                     \
+    template BhArray<T> matmul(BhArray<T>, BhArray<T>); \
+    template BhArray<T> spmv_csr(BhArray<int64_t>, BhArray<int64_t>, BhArray<T>, BhArray<T>)
 
 INSTANTIATE(bool);
 INSTANTIATE_NOBOOL(int8_t);
@@ -174,6 +192,8 @@ INSTANTIATE_NOBOOL(float);
 INSTANTIATE_NOBOOL(double);
 INSTANTIATE_NOBOOL(std::complex<float>);
 INSTANTIATE_NOBOOL(std::complex<double>);
+INSTANTIATE(bh_float16);
+INSTANTIATE(bh_bfloat16);
 
 #undef INSTANTIATE
 #undef INSTANTIATE_NOBOOL
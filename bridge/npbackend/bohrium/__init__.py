@@ -30,6 +30,7 @@ from ._util import flush, is_scalar
 from . import linalg
 from .linalg import matmul, dot, tensordot
 from .summations import *
+from .sorting import sort, argsort, unique, searchsorted
 from .disk_io import *
 from .ufuncs import _handle__array_ufunc__
 from . import contexts
@@ -66,7 +66,7 @@ def dtype_in(dtype, dtypes):
 def dtype_is_float(dtype):
     """Returns True when 'dtype' is a float or complex."""
 
-    return dtype_in(dtype, [np.float32, np.float64, np.complex64, np.complex128])
+    return dtype_in(dtype, [np.float16, np.float32, np.float64, np.complex64, np.complex128])
 
 def dtype_name(obj):
     """Returns the Bohrium name of the data type of the object 'obj'."""
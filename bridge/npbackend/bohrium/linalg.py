@@ -16,8 +16,10 @@ from numpy_force.linalg import *
 from . import bhary
 from . import ufuncs
 from . import array_create
+from . import numpy_backport
+from . import target_bhc
 from ._util import dtype_equal
-from .bhary import fix_biclass_wrapper
+from .bhary import fix_biclass_wrapper, get_bhc
 
 
 @fix_biclass_wrapper
@@ -134,10 +136,54 @@ def jacobi(a, b, tol=0.0005):
     return x
 
 
+def _broadcast_batch(a, batch_shape):
+    """Returns a view of the matrices 'a' where the leading axes are broadcasted to 'batch_shape'"""
+    nprepend = len(batch_shape) - (a.ndim - 2)
+    shape = (1,) * nprepend + a.shape[:-2]
+    strides = (0,) * nprepend + a.strides[:-2]
+    strides = tuple(0 if n == 1 else s for n, s in zip(shape, strides)) + a.strides[-2:]
+    return numpy_backport.as_strided(a, shape=tuple(batch_shape) + a.shape[-2:], strides=strides)
+
+
+def _native_matmul(a, b):
+    """
+    Matrix multiplication of the matrices in the two last axes of `a` and `b` using the
+    `matmul` extension method. The leading axes are broadcasted.
+    Raises NotImplementedError when the extension method isn't available.
+    """
+    if a.shape[-1] != b.shape[-2]:
+        raise ValueError("shapes %s and %s not aligned" % (a.shape, b.shape))
+
+    a_batch = (1,) * (b.ndim - a.ndim) + a.shape[:-2]
+    b_batch = (1,) * (a.ndim - b.ndim) + b.shape[:-2]
+    batch_shape = []
+    for n, m in zip(a_batch, b_batch):
+        if n != m and n != 1 and m != 1:
+            raise ValueError("matmul: the batch shapes %s and %s cannot be broadcasted" % (a.shape, b.shape))
+        batch_shape.append(m if n == 1 else n)
+
+    ret_shape = tuple(batch_shape) + (a.shape[-2], b.shape[-1])
+    if a.shape[-1] == 0:  # The sum of no products
+        return array_create.zeros(ret_shape, dtype=a.dtype)
+    ret = array_create.empty(ret_shape, dtype=a.dtype)
+    if ret.size > 0:
+        a = _broadcast_batch(a, batch_shape)
+        b = _broadcast_batch(b, batch_shape)
+        target_bhc.extmethod("matmul", get_bhc(ret), get_bhc(a), get_bhc(b))
+    return ret
+
+
 @fix_biclass_wrapper
 def matmul(a, b, no_blas=False):
     """
-    Matrix multiplication of two 2-D arrays.
+    Matrix product of two arrays.
+
+    If both arguments are 2-D they are multiplied like conventional matrices.
+    If either argument is N-D, N > 2, it is treated as a stack of matrices
+    residing in the last two indexes and broadcast accordingly. A 1-D
+    argument is promoted to a matrix by prepending (first argument) or
+    appending (second argument) a 1 to its dimensions, which is removed
+    after the multiplication.
 
     Parameters
     ----------
@@ -155,7 +201,14 @@ def matmul(a, b, no_blas=False):
     ------
     ValueError
         If the last dimension of `a` is not the same size as
-        the second-to-last dimension of `b`.
+        the second-to-last dimension of `b`, or if a scalar
+        value is passed.
+
+    Notes
+    -----
+    Float matrices use BLAS when the `blas` extension method is available.
+    Otherwise, the OpenMP backend multiplies all types with the native
+    `matmul` extension method.
 
     See Also
     --------
@@ -170,24 +223,39 @@ def matmul(a, b, no_blas=False):
     if not dtype_equal(a, b):
         raise ValueError("Input must be of same type")
 
-    if a.ndim != 2 and b.ndim != 2:
-        raise ValueError("Input must be 2-D.")
-
     if not (bhary.check(a) or bhary.check(b)):  # Both are regular numpy arrays
-        return numpy.dot(a, b)
+        return numpy.matmul(a, b)
     else:
         a = array_create.array(a)
         b = array_create.array(b)
 
+    if a.ndim == 0 or b.ndim == 0:
+        raise ValueError("Scalar operands are not allowed, use '*' instead")
+
+    if a.shape[-1] != b.shape[max(b.ndim - 2, 0)]:
+        raise ValueError("shapes %s and %s not aligned" % (a.shape, b.shape))
+
+    # 1-D arguments are matrices with a single row or column
+    if a.ndim == 1:
+        return matmul(a[numpy.newaxis, :], b, no_blas=no_blas)[..., 0, :]
+    if b.ndim == 1:
+        return matmul(a, b[:, numpy.newaxis], no_blas=no_blas)[..., 0]
+
     # If the dtypes are both float, we can use BLAS to calculate
     # the dot-product, if BLAS is present.
-    if not no_blas and a.dtype.kind in np.typecodes["AllFloat"] and b.dtype.kind in np.typecodes["AllFloat"]:
+    if not no_blas and a.ndim == 2 and b.ndim == 2 and \
+            a.dtype.kind in np.typecodes["AllFloat"] and b.dtype.kind in np.typecodes["AllFloat"]:
         try:
             return blas.gemm(a, b)
         except:
             pass
 
-    return ufuncs.add.reduce(a[:, numpy.newaxis] * numpy.transpose(b), -1)
+    try:
+        return _native_matmul(a, b)
+    except NotImplementedError:
+        pass
+
+    return ufuncs.add.reduce(a[..., numpy.newaxis, :] * numpy.swapaxes(b, -1, -2)[..., numpy.newaxis, :, :], -1)
 
 
 @fix_biclass_wrapper
@@ -275,6 +343,12 @@ def dot(a, b, no_blas=False):
             except:
                 pass
 
+    if a.ndim == 2 and b.ndim == 2 and dtype_equal(a, b):
+        try:
+            return _native_matmul(a, b)
+        except NotImplementedError:
+            pass
+
     return ufuncs.add.reduce(a[:, numpy.newaxis] * numpy.transpose(b), -1)
 
 
@@ -517,6 +591,63 @@ def solve_tridiagonal(a, b, c, rhs):
     return out.reshape(out_shape)
 
 
+@fix_biclass_wrapper
+def spmv_csr(indptr, indices, data, x):
+    """
+    Sparse matrix-vector multiplication,
+
+    ..math::
+        y = A x
+
+    where `A` is a sparse matrix in the compressed sparse row (CSR) format like
+    `scipy.sparse.csr_matrix`: the column indices of row `i` are `indices[indptr[i]:indptr[i+1]]`
+    and their values are `data[indptr[i]:indptr[i+1]]`.
+
+    The rows are computed in parallel if OpenMP is present where the nonzeros, rather than the rows,
+    are split evenly between the threads.
+
+    :param indptr: Row pointers of length `nrows + 1`.
+    :param indices: Column indices of the nonzeros.
+    :param data: Values of the nonzeros.
+    :param x: Dense vector of length `ncols`.
+    :returns: Dense vector of length `nrows` and the dtype of `data` and `x`.
+    """
+    indptr = array_create.array(indptr, dtype=numpy.int64)
+    indices = array_create.array(indices, dtype=numpy.int64)
+    dtype = numpy.result_type(data, x)
+    data = array_create.array(data, dtype=dtype)
+    x = array_create.array(x, dtype=dtype)
+
+    if indptr.ndim != 1 or indices.ndim != 1 or data.ndim != 1 or x.ndim != 1:
+        raise ValueError("All inputs must be one-dimensional")
+    if indptr.size == 0:
+        raise ValueError("indptr must contain at least one element")
+    if indices.shape != data.shape:
+        raise ValueError("indices and data must have equal shapes")
+
+    nrows = indptr.size - 1
+    if data.size == 0:
+        return array_create.zeros((nrows,), dtype=dtype)
+
+    out = array_create.empty((nrows,), dtype=dtype)
+    if dtype != numpy.bool_:
+        try:
+            target_bhc.extmethod("spmv_csr", get_bhc(out), get_bhc(indptr), get_bhc(indices), get_bhc(data),
+                                 get_bhc(x))
+            return out
+        except NotImplementedError:
+            pass
+
+    # Without the extension method, NumPy sums the products of each row
+    indptr = indptr.copy2numpy()
+    products = data.copy2numpy()[:indptr[-1]] * x.copy2numpy()[indices.copy2numpy()[:indptr[-1]]]
+    rows = numpy.repeat(numpy.arange(nrows), numpy.diff(indptr))
+    ret = numpy.zeros((nrows,), dtype=dtype)
+    numpy.add.at(ret, rows, products[indptr[0]:])
+    out[...] = ret
+    return out
+
+
 @fix_biclass_wrapper
 def cg(A, b, x=None, tol=1e-5, force_niter=None):
     """
@@ -8,10 +8,10 @@ from . import array_create
 from . import bhary
 from . import reorganization
 from . import array_manipulation
-from . import ufuncs
 from . import summations
+from . import target_bhc
 import numpy_force as numpy
-from .bhary import fix_biclass_wrapper
+from .bhary import fix_biclass_wrapper, get_bhc
 
 
 @fix_biclass_wrapper
@@ -118,22 +118,25 @@ def where(condition, x=None, y=None):
             array_types.append(v.dtype)
     out_type = numpy.find_common_type(array_types, scalar_types)
 
-    # Shortcut if input arrays are finite
-    if ufuncs.isfinite(x).all() and ufuncs.isfinite(y).all():
-        if numpy.isscalar(condition):
-            res = condition * x + (not condition) * y
-        else:
-            res = condition * x + ufuncs.logical_not(condition) * y
-        if numpy.isscalar(res):
-            return out_type(res)
-        else:
-            return res.astype(out_type)
+    # Convert `x` and `y` to the output type and broadcast all arguments (but the scalars)
+    (x, y) = [out_type.type(v) if numpy.isscalar(v) else array_create.array(v, dtype=out_type) for v in (x, y)]
+    (bargs, out_shape) = array_manipulation.broadcast_arrays(condition, x, y)
+    (condition, x, y) = [a if numpy.isscalar(a) else b for a, b in zip((condition, x, y), bargs)]
 
-    # General case: use fancy indexing
-    (condition, x, y), newshape = array_manipulation.broadcast_arrays(condition, x, y)
-    ret = array_create.zeros(newshape, dtype=out_type)
-    ret[condition] = x if numpy.isscalar(x) else x[condition]
-    ret[~condition] = y if numpy.isscalar(y) else y[~condition]
+    ret = array_create.empty(out_shape, dtype=out_type)
+    if numpy.isscalar(condition):
+        ret[...] = x if condition else y
+        return ret
+
+    # BH_WHERE takes at most one constant, thus a scalar `y` is materialized when `x` is a scalar as well
+    if numpy.isscalar(x) and numpy.isscalar(y):
+        tmp = array_create.empty(out_shape, dtype=out_type)
+        tmp[...] = y
+        y = tmp
+
+    # The select is a single element-wise instruction, which is fused with the computation of its operands
+    bhcs = [v if numpy.isscalar(v) else get_bhc(v) for v in (ret, condition, x, y)]
+    target_bhc.ufunc("where", *bhcs, dtypes=[out_type, numpy.dtype("bool"), out_type, out_type])
     return ret
 
 
@@ -142,6 +145,8 @@ def masked_get(ary, bool_mask):
     Get the elements of 'ary' specified by 'bool_mask'.
     """
 
+    if numpy.shape(bool_mask) == ary.shape:
+        return reorganization.pack(ary, bool_mask)
     return ary[reorganization.nonzero(bool_mask)]
 
 
@@ -150,8 +155,7 @@ def masked_set(ary, bool_mask, value):
     Set the 'value' into 'ary' at the location specified through 'bool_mask'.
     """
 
-    if numpy.isscalar(value) and ufuncs.isfinite(value):
-        ary *= ~bool_mask
-        ary += bool_mask * value
+    if numpy.isscalar(value):
+        ary[...] = where(bool_mask, value, ary)
     else:
         ary[reorganization.nonzero(bool_mask)] = value
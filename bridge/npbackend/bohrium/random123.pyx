@@ -63,8 +63,6 @@ cdef class RandomState:
     """
     cdef uint32_t key
     cdef uint64_t index
-    cdef bint has_gauss
-    cdef double gauss
 
     def __init__(self, seed=None):
         self.seed(seed)
@@ -96,7 +94,6 @@ cdef class RandomState:
         else:
             self.key = numpy.uint32(seed)
         self.index = 0;
-        self.has_gauss = False
 
     def get_state(self):
         """
@@ -215,6 +212,30 @@ cdef class RandomState:
         self.index += length
         return ret
 
+    def _bhc_random(self, size, dtype, normal=False):
+        """
+        New Bohrium array of uniform floats in [0.0, 1.0) or standard normals (`normal` is True).
+        The numbers are generated within the kernel that consumes them, thus the array is never
+        materialized when it is a temporary.
+        """
+        length = size if numpy.isscalar(size) else functools.reduce(operator.mul, size)
+        bhc_obj = target_bhc.random123(length, self.index, self.key, dtype=dtype, normal=normal)
+        ret = np.bhary.new((length,), dtype, bhc_obj).reshape(size)
+        self.index += 2 * length if normal else length
+        return ret
+
+    def _uniform(self, r_uint, dtype):
+        """
+        Convert the random bits `r_uint` to floats in [0.0, 1.0) like the Bohrium kernels do:
+        the 53 (float64) or 24 (float32) most significant bits times the machine epsilon.
+        """
+        if numpy.isscalar(r_uint):
+            r_uint = numpy.uint64(r_uint)
+        if dtype is np.float32:
+            return dtype(r_uint >> numpy.uint64(40)) * dtype(2.0 ** -24)
+        else:
+            return dtype(r_uint >> numpy.uint64(11)) * dtype(2.0 ** -53)
+
     def random_sample(self, size=None, dtype=float, bohrium=True):
         """
         Return random floats in the half-open interval [0.0, 1.0).
@@ -256,14 +277,9 @@ cdef class RandomState:
         dtype = np.dtype(dtype).type
         if not (dtype is np.float64 or dtype is np.float32):
             raise ValueError("dtype not supported for random_sample")
-        #Generate random numbers as uint
-        r_uint = self.random123(size, bohrium=bohrium)
-        #Convert random numbers to float in the interval [0.0, 1.0).
-        max_value = dtype(numpy.iinfo(numpy.uint64).max)
-        if size is None:
-            return numpy.dtype(dtype).type(r_uint) / max_value
-        else:
-            return np.array(r_uint, dtype=dtype, bohrium=bohrium) / max_value
+        if size is not None and bohrium:
+            return self._bhc_random(size, dtype)
+        return self._uniform(self.random123(size, bohrium=False), dtype)
 
     def tomaxint(self, size=None, bohrium=True):
         """
@@ -373,11 +389,19 @@ cdef class RandomState:
         if low >= high:
             raise ValueError("low >= high")
         diff = high - low
+        # A range that fits in 32 bits is the high 32 random bits scaled by the range (multiply-shift), which
+        # avoids the 64-bit division of the modulo. All of it is element-wise and fuses with the random generation.
         if size is None:
-            return dtype(dtype(self.random123(size, bohrium=bohrium) % diff) + low)
+            r_uint = self.random123(size, bohrium=bohrium)
+            r_uint = ((r_uint >> 32) * diff) >> 32 if diff <= 2 ** 32 else r_uint % diff
+            return dtype(dtype(r_uint) + low)
         else:
-            return np.array(np.array(self.random123(size, bohrium=bohrium) % diff, dtype=dtype, bohrium=bohrium) + low,
-                            dtype=dtype, bohrium=bohrium)
+            r_uint = self.random123(size, bohrium=bohrium)
+            if diff <= 2 ** 32:
+                r_uint = ((r_uint >> numpy.uint64(32)) * numpy.uint64(diff)) >> numpy.uint64(32)
+            else:
+                r_uint = r_uint % numpy.uint64(diff)
+            return np.array(np.array(r_uint, dtype=dtype, bohrium=bohrium) + low, dtype=dtype, bohrium=bohrium)
 
     def uniform(self, low=0.0, high=1.0, size=None, dtype=float, bohrium=True):
         """
@@ -668,37 +692,21 @@ cdef class RandomState:
 
         """
 
-        # Using basic Box-Muller transform
+        # Using the basic Box-Muller transform of the two uniforms of the counters `2*i` and `2*i+1` of each element,
+        # which Bohrium does within the kernel that consumes the normals
         dtype = np.dtype(dtype).type
         if not (dtype is np.float64 or dtype is np.float32):
             raise ValueError("dtype not supported for standart_normal")
+        if size is not None and bohrium:
+            return self._bhc_random(size, dtype, normal=True)
+        length = 1 if size is None else (size if numpy.isscalar(size) else functools.reduce(operator.mul, size))
+        r_uint = self.random123(2 * length, bohrium=False)
+        u1 = dtype(1) - self._uniform(r_uint[0::2], dtype)  # In (0.0, 1.0]
+        u2 = self._uniform(r_uint[1::2], dtype)
+        res = numpy.sqrt(dtype(-2) * numpy.log(u1)) * numpy.cos(dtype(2 * math.pi) * u2)
         if size is None:
-            if self.has_gauss:
-                self.has_gauss = False
-                return dtype(self.gauss)
-            else:
-                u1 = self.random_sample()
-                u2 = self.random_sample()
-                r = math.sqrt(-2. * math.log(u1))
-                t = 2. * math.pi * u2
-                z0 = r * math.cos(t)
-                z1 = r * math.sin(t)
-                self.gauss = z1
-                self.has_gauss = True
-                return dtype(z0)
-        else:
-            length = size if numpy.isscalar(size) else functools.reduce(operator.mul, size)
-            hlength = length / 2 + length % 2
-            u1 = self.random_sample(size=hlength, dtype=dtype, bohrium=bohrium)
-            u2 = self.random_sample(size=hlength, dtype=dtype, bohrium=bohrium)
-            r = np.sqrt(-2. * np.log(u1))
-            t = 2. * math.pi * u2
-            z0 = r * np.cos(t)
-            z1 = r * np.sin(t)
-            res = np.empty(hlength * 2, dtype=dtype, bohrium=bohrium)
-            res[:hlength] = z0  # res[::2] = z0
-            res[hlength:] = z1  # res[1::2] = z1
-            return res[:length].reshape(size)
+            return dtype(res[0])
+        return res.reshape(size)
 
     def normal(self, loc=0.0, scale=1.0, size=None, dtype=float, bohrium=True):
         """
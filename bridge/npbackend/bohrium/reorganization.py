@@ -423,6 +423,13 @@ def cond_scatter(ary, indexes, values, mask):
     ary[...] = flat.reshape(ary.shape)
 
 
+def _count_true(mask):
+    """Returns the number of true elements in the boolean array 'mask'"""
+    if mask.size == 0:
+        return 0
+    return int(ufuncs.add.reduce(array_create.array(mask, dtype=numpy.uint64), axis=None))
+
+
 @fix_biclass_wrapper
 def pack(ary, mask):
     """
@@ -447,14 +454,15 @@ def pack(ary, mask):
     if ary.size == 0 or mask.size == 0:
         return
 
-    true_indexes = ufuncs.add.accumulate(mask)
-    true_count = int(true_indexes[-1])
-    if true_count == 0:
-        return array_create.empty((0,), dtype=ary.dtype)
-    else:
-        ret = array_create.empty((true_count,), dtype=ary.dtype)
-        cond_scatter(ret, true_indexes - 1, ary, mask)
-        return ret
+    # The count is a reduction fused with the computation of the mask, thus only the count is synchronized
+    ret = array_create.empty((_count_true(mask),), dtype=ary.dtype)
+    if ret.size > 0:
+        try:
+            target_bhc.extmethod("compact", get_bhc(ret), get_bhc(ary), get_bhc(mask))
+        except NotImplementedError:
+            true_indexes = ufuncs.add.accumulate(mask)
+            cond_scatter(ret, true_indexes - 1, ary, mask)
+    return ret
 
 
 @fix_biclass_wrapper
@@ -488,10 +496,16 @@ def flatnonzero(a):
     array([-2, -1,  1,  2])
     """
 
-    if a.dtype is not numpy.bool:
-        mask = a != 0
-    new_indexes = array_create.arange(a.size, dtype=numpy.uint64)
-    return pack(new_indexes, mask)
+    a = array_create.array(a)
+    mask = a if a.dtype == numpy.bool else a != 0
+    mask = array_manipulation.flatten(mask, always_copy=False)
+    ret = array_create.empty((_count_true(mask),), dtype=numpy.uint64)
+    if ret.size > 0:
+        try:
+            target_bhc.extmethod("flatnonzero", get_bhc(ret), get_bhc(mask), get_bhc(mask))
+        except NotImplementedError:
+            ret = pack(array_create.arange(a.size, dtype=numpy.uint64), mask)
+    return ret
 
 
 @fix_biclass_wrapper
@@ -8,11 +8,42 @@ Common signal processing functions, which often handle multiple dimension
 import numpy_force as numpy
 from . import array_create
 from . import bhary
-from . import ufuncs
-from . import linalg
-from . import summations
 from . import _util
-from . import numpy_backport
+from . import target_bhc
+from .bhary import get_bhc
+
+# The number of filter taps that the correlation without the extension method sums between flushes
+_TAPS_PER_FLUSH = 64
+
+
+def _correlate_valid(ary, filter):
+    """
+    Correlation of `ary` and `filter` in 'valid' mode where both have the same dtype and number of dimensions.
+    The OpenMP backend calculates all filter taps in one pass with the `correlate` extension method.
+    """
+    shape = tuple(n - m + 1 for n, m in zip(ary.shape, filter.shape))
+    ret = array_create.empty(shape, dtype=ary.dtype, bohrium=bhary.check(ary))
+    if ret.size == 0:
+        return ret
+    if bhary.check(ret):
+        try:
+            filter = array_create.array(filter)
+            target_bhc.extmethod("correlate", get_bhc(ret), get_bhc(ary), get_bhc(filter))
+            return ret
+        except NotImplementedError:
+            pass
+
+    # Without the extension method, we sum the filter taps one at a time
+    if bhary.check(filter):
+        filter = filter.copy2numpy()
+    ret[...] = 0
+    for i, k in enumerate(numpy.ndindex(*filter.shape)):
+        ret += ary[tuple(slice(j, j + n) for j, n in zip(k, shape))] * filter[k]
+        # The time the fuser spends grows faster than the number of instructions in a flush, thus we flush a
+        # batch of taps at a time rather than all taps of a large filter at once
+        if bhary.check(ret) and (i + 1) % _TAPS_PER_FLUSH == 0:
+            _util.flush()
+    return ret
 
 
 # 1d
@@ -29,14 +60,9 @@ def _correlate_and_convolve_body(vector, filter, d, mode):
         filter = numpy.conj(filter)
 
     dtype = numpy.result_type(vector, filter)
-    rows = int(ufuncs.ceil((vector.size + 2 * filter.size - 2) / float(filter.size)))
-    padded = array_create.empty([rows * filter.size], dtype=dtype)
-    padded[0:filter.size - 1] = 0
+    padded = array_create.zeros([vector.size + 2 * filter.size - 2], dtype=dtype)
     padded[filter.size - 1:vector.size + filter.size - 1] = vector
-    padded[vector.size + filter.size - 1:] = 0
-    s = numpy_backport.as_strided(padded, shape=(padded.shape[0] - filter.size + 1, filter.size),
-                                  strides=(padded.strides[0], padded.strides[0]))
-    result = linalg.dot(s, filter)
+    result = _correlate_valid(padded, filter.astype(dtype))
     if mode == 'same':
         return result[d:vector.size + d]
     elif mode == 'full':
@@ -94,79 +120,6 @@ def convolve1d(a, v, mode='full'):
 
 # Nd
 # ---------------------------------------------------------------------------------
-def _findIndices(ArrSize, FilterSize):
-    N = FilterSize.shape[0]
-    n = int(FilterSize.prod())
-    CumSizeArr = numpy.ones([N], dtype=numpy.int32)
-    CumSizeArr[1:N] = ArrSize[0:N - 1].cumprod()
-    CumSize = numpy.ones([N], dtype=numpy.int32)
-    CumSize[1:N] = FilterSize[0:N - 1].cumprod()
-
-    vals = numpy.empty((n, N), dtype=numpy.int32)
-    for i in range(N):
-        vals[:, i] = numpy.linspace(0, n - 1, n)
-
-    vals = vals // CumSize
-    vals = vals % FilterSize
-    CurrPos = summations.sum(vals * CumSizeArr, axis=1)
-
-    return CurrPos.astype(numpy.int32)
-
-
-def _addZerosNd(Array, FilterSize, dtype):
-    # Introduces zero padding for Column major flattening
-    PaddedSize = numpy.array(Array.shape, dtype=numpy.int32)
-    N = FilterSize.shape[0]
-    PaddedSize[0:N] += FilterSize - 1
-    cut = '['
-    for i in range(PaddedSize.shape[0]):
-        if i < N:
-            minpos = int(FilterSize[i] / 2)
-            maxpos = Array.shape[i] + int(FilterSize[i] / 2)
-        else:
-            minpos = 0
-            maxpos = Array.shape[i]
-        cut += str(minpos) + ':' + str(maxpos) + ','
-    cut = cut[:-1] + ']'
-    Padded = array_create.zeros(PaddedSize, dtype=dtype, bohrium=bhary.check(Array))
-    exec ('Padded' + cut + '=Array')
-    return Padded
-
-
-def _findSame(Array, FilterSize):
-    # Numpy convention. Returns view of the same size as the largest input
-    N = FilterSize.shape[0]
-    cut = '['
-    for i in range(len(Array.shape)):
-        if i < N:
-            minpos = (FilterSize[i] - 1) // 2
-            maxpos = Array.shape[i] - (FilterSize[i]) // 2
-        else:
-            minpos = 0
-            maxpos = Array.shape[i]
-        cut += str(minpos) + ':' + str(maxpos) + ','
-    cut = cut[:-1] + ']'
-    res = eval('Array' + cut)
-    return res
-
-
-def _findValid(Array, FilterSize):
-    # Cuts the result down to only totally overlapping views
-    N = FilterSize.shape[0]
-    cut = '['
-    for i in range(len(Array.shape)):
-        if i < N:
-            minpos = FilterSize[i] - 1
-            maxpos = Array.shape[i] - FilterSize[i] + 1
-        else:
-            minpos = 0
-            maxpos = Array.shape[i]
-        cut += str(minpos) + ':' + str(maxpos) + ','
-    cut = cut[:-1] + ']'
-    res = eval('Array' + cut)
-    return res
-
-
 def _invert_ary(a):
     """Reverse all elements in each axis"""
 
@@ -195,56 +148,36 @@ def _correlate_kernel(Array, Filter, mode):
     if numpy.iscomplexobj(Filter):
         Filter = numpy.conj(Filter)
 
-    # Get sizes as arrays for easier manipulation
-    ArrSize = numpy.array(Array.shape, dtype=numpy.int32)
-    FilterSize = numpy.array(Filter.shape, dtype=numpy.int32)
-
     # Check that mode='valid' is allowed given the array sizes
     if mode == 'valid':
-        diffSize = ArrSize[:FilterSize.size] - FilterSize
-        nSmaller = summations.sum(diffSize < 0)
-        if nSmaller > 0:
+        if any(n < m for n, m in zip(Array.shape, Filter.shape)):
             raise ValueError(
                 "correlateNd: For 'valid' mode, one must be at least as large as the other in every dimension")
+    elif mode not in ('full', 'same'):
+        raise ValueError("correlateNd: invalid mode '%s'" % mode)
 
     # Use numpy convention for result dype
     dtype = numpy.result_type(Array, Filter)
 
-    # Add zeros along relevant dimensions
-    Padded = _addZerosNd(Array, FilterSize, dtype)
-    PaddedSize = numpy.array(Padded.shape, dtype=numpy.int32)
-
-    # Get positions of first view
-    IndiVec = _findIndices(PaddedSize, FilterSize)
-    CenterPos = tuple((FilterSize - 1) // 2)
-    IndiMat = IndiVec.reshape(FilterSize, order='F')
-    nPre = IndiMat[CenterPos]  # Required zeros before Array for correct alignment
-    nPost = IndiVec[Filter.size - 1] - nPre
-    n = Padded.size
-    nTot = n + nPre + nPost  # Total size after pre/post padding
-    V = array_create.empty([nTot], dtype=dtype, bohrium=bhary.check(Array))
-    V[nPre:n + nPre] = Padded.flatten(order='F')
-    V[:nPre] = 0
-    V[n + nPre:] = 0
-    A = Filter.flatten(order='F')
-
-    # Actual correlation calculation
-    Correlated = V[IndiVec[0]:n + IndiVec[0]] * A[0]
-    for i in range(1, Filter.size):
-        Correlated += V[IndiVec[i]:n + IndiVec[i]] * A[i]
-        # TODO: we need this flush because of very slow fusion
-        if bhary.check(V):
-            _util.flush()
+    # The filter covers the leading dimensions of the array
+    Filter = Filter.reshape(Filter.shape + (1,) * (Array.ndim - Filter.ndim)).astype(dtype)
 
-    Full = Correlated.reshape(PaddedSize, order='F')
+    # Add the zeros that the filter overlaps at the borders, which depends on the mode
     if mode == 'full':
-        return Full
+        pads = [(m - 1, m - 1) for m in Filter.shape]
     elif mode == 'same':
-        return _findSame(Full, FilterSize)
-    elif mode == 'valid':
-        return _findValid(Full, FilterSize)
+        pads = [(m // 2, m - 1 - m // 2) for m in Filter.shape]
     else:
-        raise ValueError("correlateNd: invalid mode '%s'" % mode)
+        pads = [(0, 0) for m in Filter.shape]
+    if any(before + after > 0 for before, after in pads):
+        shape = [n + before + after for n, (before, after) in zip(Array.shape, pads)]
+        Padded = array_create.zeros(shape, dtype=dtype, bohrium=bhary.check(Array))
+        Padded[tuple(slice(before, before + n) for n, (before, _) in zip(Array.shape, pads))] = Array
+    elif Array.dtype != dtype:
+        Padded = Array.astype(dtype)
+    else:
+        Padded = Array
+    return _correlate_valid(Padded, Filter)
 
 
 def convolve(a, v, mode='full'):
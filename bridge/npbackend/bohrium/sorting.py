@@ -0,0 +1,240 @@
+"""
+Sorting
+~~~~~~~
+
+Sorting along an axis, which the OpenMP backend does in parallel (see the `sort` extension method),
+and searching in sorted arrays
+
+"""
+import numpy_force as numpy
+from . import array_create
+from . import array_manipulation
+from . import bhary
+from . import reorganization
+from . import target_bhc
+from . import ufuncs
+from .bhary import fix_biclass_wrapper, get_bhc
+
+
+def _sort(name, a, axis, out_dtype):
+    """Apply the sort extension method 'name' along 'axis' of 'a' and returns the result of type 'out_dtype'"""
+
+    a = array_create.array(a)
+    if axis is None:
+        a = array_manipulation.flatten(a, always_copy=False)
+        axis = -1
+    if a.ndim == 0:
+        raise ValueError("Cannot sort a 0-d array")
+    if axis < 0:
+        axis += a.ndim
+
+    # The extension method sorts along the last axis, thus we swap `axis` and the last axis of the views
+    ret = array_create.empty(a.shape, dtype=out_dtype)
+    a_view = a.swapaxes(axis, -1)
+    ret_view = ret.swapaxes(axis, -1)
+    try:
+        target_bhc.extmethod(name, get_bhc(ret_view), get_bhc(a_view), get_bhc(a_view))
+    except NotImplementedError:
+        func = numpy.sort if name == "sort" else numpy.argsort
+        ret[...] = func(a.copy2numpy(), axis=axis, kind="mergesort")
+    return ret
+
+
+@fix_biclass_wrapper
+def sort(a, axis=-1, kind='quicksort', order=None):
+    """
+    Return a sorted copy of an array.
+
+    Parameters
+    ----------
+    a : array_like
+        Array to be sorted.
+    axis : int or None, optional
+        Axis along which to sort. If None, the array is flattened before
+        sorting. The default is -1, which sorts along the last axis.
+    kind : {'quicksort', 'mergesort', 'heapsort'}, optional
+        Ignored, Bohrium always does a stable sort: a radix sort of integer
+        and float arrays and a merge sort of complex arrays.
+    order : str or list of str, optional
+        Not supported by Bohrium.
+
+    Returns
+    -------
+    sorted_array : ndarray
+        Array of the same type and shape as `a`.
+
+    Notes
+    -----
+    NaNs are sorted to the end like in NumPy.
+
+    Examples
+    --------
+    >>> a = np.array([[1,4],[3,1]])
+    >>> np.sort(a)                # sort along the last axis
+    array([[1, 4],
+           [1, 3]])
+    >>> np.sort(a, axis=None)     # sort the flattened array
+    array([1, 1, 3, 4])
+    >>> np.sort(a, axis=0)        # sort along the first axis
+    array([[1, 1],
+           [3, 4]])
+    """
+
+    if not bhary.check(a) or order is not None:
+        return numpy.sort(a, axis=axis, kind=kind, order=order)
+    return _sort("sort", a, axis, a.dtype)
+
+
+@fix_biclass_wrapper
+def argsort(a, axis=-1, kind='quicksort', order=None):
+    """
+    Returns the indices that would sort an array.
+
+    Parameters
+    ----------
+    a : array_like
+        Array to sort.
+    axis : int or None, optional
+        Axis along which to sort. The default is -1 (the last axis). If None,
+        the flattened array is used.
+    kind : {'quicksort', 'mergesort', 'heapsort'}, optional
+        Ignored, Bohrium always does a stable sort.
+    order : str or list of str, optional
+        Not supported by Bohrium.
+
+    Returns
+    -------
+    index_array : ndarray, int64
+        Array of indices that sort `a` along the specified axis.
+
+    Examples
+    --------
+    >>> x = np.array([3, 1, 2])
+    >>> np.argsort(x)
+    array([1, 2, 0])
+    """
+
+    if not bhary.check(a) or order is not None:
+        return numpy.argsort(a, axis=axis, kind=kind, order=order)
+    return _sort("argsort", a, axis, numpy.int64)
+
+
+@fix_biclass_wrapper
+def unique(ar, return_index=False, return_inverse=False, return_counts=False, axis=None):
+    """
+    Find the unique elements of an array.
+
+    Returns the sorted unique elements of an array. Bohrium only supports
+    the flattened array, the other options are handled by NumPy.
+
+    Parameters
+    ----------
+    ar : array_like
+        Input array, which is flattened.
+
+    Returns
+    -------
+    unique : ndarray
+        The sorted unique values.
+
+    Examples
+    --------
+    >>> np.unique([1, 1, 2, 2, 3, 3])
+    array([1, 2, 3])
+    """
+
+    if not bhary.check(ar) or return_index or return_inverse or return_counts or axis is not None:
+        return numpy.unique(ar, return_index=return_index, return_inverse=return_inverse,
+                            return_counts=return_counts, axis=axis)
+
+    s = sort(ar, axis=None)
+    if s.size < 2:
+        return s
+
+    # The first element of each run of equal elements is unique
+    mask = array_create.empty(s.shape, dtype=numpy.bool)
+    mask[0] = True
+    mask[1:] = s[1:] != s[:-1]
+    return reorganization.pack(s, mask)
+
+
+@fix_biclass_wrapper
+def searchsorted(a, v, side='left', sorter=None):
+    """
+    Find indices where elements should be inserted to maintain order.
+
+    Bohrium does a binary search of all elements of `v` at once, which
+    takes log2(len(a)) gathers from `a`. Complex arrays are handled by NumPy.
+
+    Parameters
+    ----------
+    a : 1-D array_like
+        Input array, which must be sorted in ascending order unless `sorter`
+        is given (e.g. the output of `sort()`).
+    v : array_like
+        Values to insert into `a`.
+    side : {'left', 'right'}, optional
+        If 'left', the index of the first suitable location found is given.
+        If 'right', return the last such index.
+    sorter : 1-D array_like, optional
+        Array of indices that sort `a` (e.g. the output of `argsort()`).
+
+    Returns
+    -------
+    indices : array of ints
+        Array of insertion points with the same shape as `v`.
+
+    Notes
+    -----
+    NaNs are sorted to the end like in NumPy.
+
+    Examples
+    --------
+    >>> np.searchsorted([1,2,3,4,5], 3)
+    2
+    >>> np.searchsorted([1,2,3,4,5], 3, side='right')
+    3
+    >>> np.searchsorted([1,2,3,4,5], [-10, 10, 2, 3])
+    array([0, 5, 1, 2])
+    """
+
+    if not bhary.check(a) and not bhary.check(v):
+        return numpy.searchsorted(a, v, side=side, sorter=sorter)
+    if side not in ('left', 'right'):
+        raise ValueError("side must be 'left' or 'right' (got %r)" % side)
+
+    a = array_create.array(a)
+    v = array_create.array(v)
+    if a.ndim != 1:
+        raise ValueError("object too deep for desired array")
+    if sorter is not None:
+        a = reorganization.take(a, sorter)
+
+    dtype = numpy.result_type(a.dtype, v.dtype)
+    if dtype.kind == 'c':
+        ret = numpy.searchsorted(a.copy2numpy(), v.copy2numpy(), side=side)
+        return array_create.array(ret)
+    a = array_create.array(a, dtype=dtype)
+    v = array_create.array(v, dtype=dtype)
+    shape = v.shape
+    v = array_manipulation.flatten(v, always_copy=False)
+
+    # `ret` counts the elements of `a` that go before `v`, which we find by trying to add decreasing powers of two
+    ret = array_create.zeros(v.shape, dtype=numpy.int64)
+    step = 1 << (a.size.bit_length() - 1) if a.size > 0 else 0
+    while step > 0:
+        nxt = ret + step
+        x = reorganization.take(a, ufuncs.minimum(nxt, a.size) - 1)
+        if side == 'left':
+            before = x < v
+            if dtype.kind == 'f':
+                before |= ufuncs.isnan(v) & ~ufuncs.isnan(x)
+        else:
+            after = v < x
+            if dtype.kind == 'f':
+                after |= ufuncs.isnan(x) & ~ufuncs.isnan(v)
+            before = ~after
+        before &= nxt <= a.size
+        ret += before.astype(numpy.int64) * step
+        step >>= 1
+    return ret.reshape(shape)
@@ -235,12 +235,16 @@ def ufunc(op, *args, **kwd):
             scalar_type = dtype_name(args[1])
 
     fname = "%s" % op
-    for arg, dtype in zip(args, dtypes):
+    args = list(args)
+    for i, (arg, dtype) in enumerate(zip(args, dtypes)):
         if numpy.isscalar(arg):
             if dtype is None:
                 fname += "_K%s" % scalar_type
             else:
                 fname += "_K%s" % dtype_name(dtype)
+            # Bohrium-C takes float16 scalars as their bit pattern
+            if fname.endswith("_Kfloat16"):
+                args[i] = int(numpy.float16(arg).view(numpy.uint16))
         else:
             if dtype is None:
                 fname += "_A%s" % dtype_name(arg)
@@ -278,7 +282,7 @@ def accumulate(op, out, ary, axis):
     ufunc("%s_accumulate" % op.info['name'], out, ary, axis, dtypes=[None, None, numpy.dtype("int64")])
 
 
-def extmethod(name, out, in1, in2):
+def extmethod(name, out, in1, in2, *ins):
     """
     Apply the extended method 'name'
 
@@ -286,18 +290,16 @@ def extmethod(name, out, in1, in2):
     :out ?:
     :in1 ?:
     :in2 ?:
+    :ins ?: Additional inputs of extension methods that take more than two inputs
     :rtype: None
     """
     if out.size == 0 or out.base.size == 0:
         return
 
-    func = getattr(bhc, "extmethod_A%s_A%s_A%s" % (
-        dtype_name(out),
-        dtype_name(in1),
-        dtype_name(in2)
-    ))
+    operands = (out, in1, in2) + ins
+    func = getattr(bhc, "extmethod" + "".join("_A%s" % dtype_name(op) for op in operands))
 
-    ret = _bhc_exec(func, name, out, in1, in2)
+    ret = _bhc_exec(func, name, *operands)
 
     if ret != 0:
         raise NotImplementedError("The current runtime system does not support "
@@ -323,20 +325,24 @@ def arange(size, dtype):
     return ret
 
 
-def random123(size, start_index, key):
+def random123(size, start_index, key, dtype=numpy.uint64, normal=False):
     """
     Create a new random array using the random123 algorithm.
-    The dtype is uint64 always.
+    A uint64 array is the raw random bits, a float32/float64 array is uniform in [0, 1),
+    and a float32/float64 array of standard normals when 'normal' is true.
+    NB: the normals uses two counters per element, thus 'start_index' must be incremented by 2 * 'size'
     """
 
-    dtype = numpy.dtype("uint64")
+    dtype = numpy.dtype(dtype)
+    uint64 = numpy.dtype("uint64")
 
     # Create new array
     ret = View(1, 0, (size,), (1,), Base(size, dtype))
 
-    # And apply the range operation
+    # And apply the random operation, which is generated within the kernel that consumes the result
     if size > 0:
-        ufunc("random123", ret, start_index, key, dtypes=[dtype] * 3)
+        name = "random123_normal" if normal else "random123"
+        ufunc(name, ret, start_index, key, dtypes=[dtype, uint64, uint64])
 
     return ret
 
@@ -502,6 +502,9 @@ class Ufunc(object):
 # Expose via UFUNCS
 UFUNCS = {}
 for op in _info.op.values():
+    # NumPy's `where()` isn't a ufunc, BH_WHERE is used by `masking.where()` instead
+    if op['name'] == "where":
+        continue
     f = Ufunc(op)
     UFUNCS[f.info['name']] = f
 
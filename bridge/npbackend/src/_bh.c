@@ -725,6 +725,10 @@ static PyObject* BhArray_take(PyObject *self, PyObject *args, PyObject *kwds) {
     return method2function("take", self, args, kwds);
 }
 
+static PyObject* BhArray_argsort(PyObject *self, PyObject *args, PyObject *kwds) {
+    return method2function("argsort", self, args, kwds);
+}
+
 static PyObject* BhArray_put(PyObject *self, PyObject *args, PyObject *kwds) {
     return method2function("put", self, args, kwds);
 }
@@ -763,6 +767,7 @@ static PyMethodDef BhArrayMethods[] = {
     {"trace",              (PyCFunction) BhArray_trace,         METH_VARARGS | METH_KEYWORDS, "a.trace(offset=0, axis1=0, axis2=1, dtype=None, out=None)\n\nReturn the sum along diagonals of the array."},
     {"tofile",             (PyCFunction) BhArray_print_to_file, METH_VARARGS | METH_KEYWORDS, "a.tofile(fid, sep=\"\", format=\"%s\")\n\nWrite array to a file as text or binary (default)."},
     {"take",               (PyCFunction) BhArray_take,          METH_VARARGS | METH_KEYWORDS, "a.take(indices, axis=None, out=None, mode='raise')."},
+    {"argsort",            (PyCFunction) BhArray_argsort,       METH_VARARGS | METH_KEYWORDS, "a.argsort(axis=-1, kind='quicksort', order=None)\n\nReturns the indices that would sort this array.\n\nRefer to `bohrium.argsort` for full documentation."},
     {"put",                (PyCFunction) BhArray_put,           METH_VARARGS | METH_KEYWORDS, "a.put(indices, values, mode='raise')\n\nSet a.flat[n] = values[n] for all n in indices."},
     {"mean",               (PyCFunction) BhArray_mean,          METH_VARARGS | METH_KEYWORDS, "a.mean(a, axis=None, dtype=None, out=None)\n\n Compute the arithmetic mean along the specified axis."},
     {NULL, NULL, 0, NULL} /* Sentinel */
@@ -55,6 +55,8 @@ void bh_set_constant(int npy_type, bh_constant* constant, void* data) {
     #endif
         case NPY_ULONGLONG:
             constant->value.uint64 = *(npy_ulonglong*)data;
+        case NPY_HALF:
+            constant->value.float16.bits = *(npy_half*)data;
         case NPY_FLOAT:
             constant->value.float32 = *(npy_float*)data;
         case NPY_DOUBLE:
@@ -104,6 +106,8 @@ void bh_set_int_constant(int npy_type, bh_constant* constant, long long integer)
     #endif
         case NPY_ULONGLONG:
             constant->value.uint64 = integer;
+        case NPY_HALF:
+            constant->value.float16.bits = npy_float_to_half(integer);
         case NPY_FLOAT:
             constant->value.float32 = integer;
         case NPY_DOUBLE:
@@ -145,6 +149,7 @@ bh_type type_py2cph(int npy_type)
         #endif
         case NPY_LONGLONG:  return BH_INT64;
         case NPY_ULONGLONG: return BH_UINT64;
+        case NPY_HALF:      return BH_FLOAT16;
         case NPY_FLOAT:     return BH_FLOAT32;
         case NPY_DOUBLE:    return BH_FLOAT64;
         case NPY_CFLOAT:    return BH_COMPLEX64;
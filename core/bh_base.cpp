@@ -46,6 +46,7 @@ void bh_create_base(bh_type type, int64_t nelements, bh_base** new_base)
     base->type  = type;
     base->nelem = nelements;
     base->data  = NULL;
+    base->packed = false;
     *new_base   = base;
 }
 
@@ -128,7 +129,10 @@ void bh_data_free(bh_base* base)
     int64_t bytes;
 
     if(base == NULL) return;
-    if(base->data == NULL) return;
+    if(base->data == NULL) {
+        base->packed = false;
+        return;
+    }
 
     bytes = bh_base_size(base);
 
@@ -140,9 +144,43 @@ void bh_data_free(bh_base* base)
     }
 
     base->data = NULL;
+    base->packed = false;
     return;
 }
 
+/* Converts the data of a bit-packed boolean array into one byte per element.
+ * For convenience, the base is allowed to be NULL or not packed.
+ *
+ * @base    The base in question
+ */
+void bh_data_unpack(bh_base* base)
+{
+    if(base == NULL or not base->packed) return;
+    if(base->data == NULL) {
+        base->packed = false;
+        return;
+    }
+
+    const uint32_t *words = (const uint32_t *) base->data;
+    const int64_t packed_bytes = bh_base_size(base);
+
+    base->packed = false;
+    base->data = NULL;
+    bh_data_malloc(base);
+
+    bool *data = (bool *) base->data;
+    for(int64_t i = 0; i < base->nelem; ++i) {
+        data[i] = (words[i >> 5] >> (i & 31)) & 1u;
+    }
+
+    if(bh_memory_free((void *) words, packed_bytes) != 0) {
+        stringstream ss;
+        ss << "bh_data_unpack() could not free a data region. " \
+           << "Returned error code: " << strerror(errno);
+        throw runtime_error(ss.str());
+    }
+}
+
 /* Size of the base array in bytes
  *
  * @base    The base in question
@@ -150,5 +188,8 @@ void bh_data_free(bh_base* base)
  */
 int64_t bh_base_size(const bh_base *base)
 {
+    if (base->packed) {
+        return (base->nelem + 31) / 32 * 4;
+    }
     return base->nelem * bh_type_size(base->type);
 }
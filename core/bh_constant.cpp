@@ -98,6 +98,10 @@ double bh_constant::get_double() const
             return static_cast<double>(value.float32);
         case bh_type::FLOAT64:
             return value.float64;
+        case bh_type::FLOAT16:
+            return static_cast<double>(bh_float16_to_float32(value.float16));
+        case bh_type::BFLOAT16:
+            return static_cast<double>(bh_bfloat16_to_float32(value.bfloat16));
         case bh_type::COMPLEX64:
             if (value.complex64.imag != 0){
                 throw overflow_error("Complex64 cannot be converted"
@@ -153,6 +157,12 @@ void bh_constant::set_double(double value)
         case bh_type::FLOAT64:
             this->value.float64 = value;
             return;
+        case bh_type::FLOAT16:
+            this->value.float16 = bh_float32_to_float16(static_cast<float>(value));
+            return;
+        case bh_type::BFLOAT16:
+            this->value.bfloat16 = bh_float32_to_bfloat16(static_cast<float>(value));
+            return;
         case bh_type::COMPLEX64:
             this->value.complex64.real = static_cast<int32_t>(value);
             this->value.complex64.imag = 0;
@@ -195,6 +205,10 @@ bool bh_constant::operator==(const bh_constant& other) const
             return other.value.float32 == value.float32;
         case bh_type::FLOAT64:
             return other.value.float64 == value.float64;
+        case bh_type::FLOAT16:
+            return other.value.float16.bits == value.float16.bits;
+        case bh_type::BFLOAT16:
+            return other.value.bfloat16.bits == value.bfloat16.bits;
         case bh_type::COMPLEX64:
             return other.value.complex64.real == value.complex64.real &&
                    other.value.complex64.imag == value.complex64.imag;
@@ -259,6 +273,12 @@ void bh_constant::pprint(ostream& out, bool opencl) const
             case bh_type::FLOAT64:
                 ppfloat(value.float64, out);
                 break;
+            case bh_type::FLOAT16: // The kernels see the 16-bit floats as their bit pattern
+                out << std::hex << std::showbase << value.float16.bits << "u" << std::dec << std::noshowbase;
+                break;
+            case bh_type::BFLOAT16:
+                out << std::hex << std::showbase << value.bfloat16.bits << "u" << std::dec << std::noshowbase;
+                break;
             case bh_type::R123:
                 out << "{.start = " << value.r123.start << ", .key = " << value.r123.key << "}";
                 break;
@@ -26,6 +26,7 @@ If not, see <http://www.gnu.org/licenses/>.
 #include <cassert>
 #include <sstream>
 #include <limits>
+#include <cstring>
 
 int bh_type_size(bh_type type)
 {
@@ -45,6 +46,8 @@ int bh_type_size(bh_type type)
         case bh_type::COMPLEX64:  return  8;
         case bh_type::COMPLEX128: return 16;
         case bh_type::R123:       return 16;
+        case bh_type::FLOAT16:    return  2;
+        case bh_type::BFLOAT16:   return  2;
 	}
     return -1;
 }
@@ -67,6 +70,8 @@ const char* bh_type_text(bh_type type)
         case bh_type::COMPLEX64:  return "BH_COMPLEX64";
         case bh_type::COMPLEX128: return "BH_COMPLEX128";
         case bh_type::R123:       return "BH_R123";
+        case bh_type::FLOAT16:    return "BH_FLOAT16";
+        case bh_type::BFLOAT16:   return "BH_BFLOAT16";
     }
     return "UNKNOWN";
 }
@@ -120,6 +125,8 @@ int bh_type_is_signed_integer(bh_type type)
 int bh_type_is_float(bh_type type)
 {
     switch (type) {
+        case bh_type::FLOAT16:
+        case bh_type::BFLOAT16:
         case bh_type::FLOAT32:
         case bh_type::FLOAT64:
         case bh_type::COMPLEX64:
@@ -130,6 +137,11 @@ int bh_type_is_float(bh_type type)
     }
 }
 
+int bh_type_is_half(bh_type type)
+{
+    return type == bh_type::FLOAT16 or type == bh_type::BFLOAT16;
+}
+
 int bh_type_is_complex(bh_type type)
 {
     switch(type)
@@ -184,6 +196,8 @@ double bh_type_limit_max_float(bh_type type)
 {
     switch(type)
     {
+        case bh_type::FLOAT16:  return 16;
+        case bh_type::BFLOAT16: return FLT_MAX_EXP;
         case bh_type::FLOAT32: return FLT_MAX_EXP;
         case bh_type::FLOAT64: return DBL_MAX_EXP;
         default:
@@ -196,6 +210,8 @@ double bh_type_limit_min_float(bh_type type)
 {
     switch(type)
     {
+        case bh_type::FLOAT16:  return -13;
+        case bh_type::BFLOAT16: return FLT_MIN_EXP;
         case bh_type::FLOAT32: return FLT_MIN_EXP;
         case bh_type::FLOAT64: return DBL_MIN_EXP;
         default:
@@ -203,3 +219,69 @@ double bh_type_limit_min_float(bh_type type)
             return 0;
     }
 }
+
+namespace {
+// The bit pattern of a single precision float and back
+uint32_t float_bits(float val) {
+    uint32_t ret;
+    memcpy(&ret, &val, sizeof(ret));
+    return ret;
+}
+float bits_float(uint32_t bits) {
+    float ret;
+    memcpy(&ret, &bits, sizeof(ret));
+    return ret;
+}
+}
+
+float bh_float16_to_float32(bh_float16 val)
+{
+    const uint32_t sign = (uint32_t)(val.bits & 0x8000u) << 16;
+    const uint32_t exp = (val.bits >> 10) & 0x1Fu;
+    const uint32_t mant = val.bits & 0x3FFu;
+    if (exp == 0x1F) { // Inf or NaN
+        return bits_float(sign | 0x7F800000u | (mant << 13));
+    }
+    if (exp == 0) { // Zero or subnormal, which is exactly mant * 2^-24
+        const float ret = (float)mant * 5.9604644775390625e-08f;
+        return sign ? -ret : ret;
+    }
+    return bits_float(sign | ((exp + 112) << 23) | (mant << 13));
+}
+
+bh_float16 bh_float32_to_float16(float val)
+{
+    const uint32_t bits = float_bits(val);
+    const uint16_t sign = (uint16_t)((bits >> 16) & 0x8000u);
+    const uint32_t abs = bits & 0x7FFFFFFFu;
+    bh_float16 ret;
+    if (abs >= 0x7F800000u) { // Inf or NaN, where NaN stays a quiet NaN
+        ret.bits = sign | 0x7C00u | (abs > 0x7F800000u ? 0x200u : 0u);
+    } else if (abs >= 0x477FF000u) { // Rounds to a magnitude above 65504
+        ret.bits = sign | 0x7C00u;
+    } else if (abs < 0x38800000u) { // Subnormal or zero, rounded by the float addition
+        const float tmp = bits_float(abs) + 0.5f;
+        ret.bits = sign | (uint16_t)(float_bits(tmp) - 0x3F000000u);
+    } else {
+        const uint32_t odd = (abs >> 13) & 1u;
+        ret.bits = sign | (uint16_t)((abs - 0x38000000u + 0xFFFu + odd) >> 13);
+    }
+    return ret;
+}
+
+float bh_bfloat16_to_float32(bh_bfloat16 val)
+{
+    return bits_float((uint32_t)val.bits << 16);
+}
+
+bh_bfloat16 bh_float32_to_bfloat16(float val)
+{
+    const uint32_t bits = float_bits(val);
+    bh_bfloat16 ret;
+    if ((bits & 0x7FFFFFFFu) > 0x7F800000u) { // NaN stays a quiet NaN
+        ret.bits = (uint16_t)((bits >> 16) | 0x40u);
+    } else {
+        ret.bits = (uint16_t)((bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16);
+    }
+    return ret;
+}
@@ -41,5 +41,16 @@ void Scope::writeIdxDeclaration(const bh_view &view, const string &type_str, str
     out << ");";
 }
 
+void Scope::writeOffsetDeclaration(const bh_view &view, int rank, const string &type_str, stringstream &out) {
+    assert(offsetRank(view) < rank);
+    assert(rank < view.ndim - 1);
+    out << "const " << type_str << " ";
+    getOffsetName(view, rank, out);
+    out << " = ";
+    write_array_offset(*this, view, rank, out);
+    out << ";";
+    _declared_offset[view] = rank;
+}
+
 } // jitk
 } // bohrium
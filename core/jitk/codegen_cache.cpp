@@ -22,6 +22,7 @@ If not, see <http://www.gnu.org/licenses/>.
 #include <iostream>
 
 #include <jitk/codegen_cache.hpp>
+#include <jitk/codegen_util.hpp>
 
 using namespace std;
 
@@ -39,6 +40,13 @@ void hash_stream(const bh_view &view, const SymbolTable &symbols, std::stringstr
 
     if (symbols.strides_as_var) {
         ss << "strideid: " << symbols.offsetStridesID(view);
+        // The hoisting of broadcast views depends on which strides are zero
+        if (symbols.hoist_broadcast) {
+            ss << "zero strides: ";
+            for (int j = 0; j < view.ndim; ++j) {
+                ss << (view.stride[j] == 0);
+            }
+        }
     } else {
         ss << "vstart: " << view.start;
         for (int j = 0; j < view.ndim; ++j) {
@@ -85,25 +93,36 @@ void hash_stream(const Block &block, const SymbolTable &symbols, std::stringstre
         for (const Block &b: block.getLoop()._block_list) {
             hash_stream(b, symbols, ss);
         }
+        // The sliding windows depend on the offsets of the views, which the offset-and-strides IDs don't capture
+        if (symbols.sliding_window and symbols.strides_as_var and block.getLoop().isInnermost()) {
+            const LoopB &loop = block.getLoop();
+            for (const SlidingWindow &window: sliding_windows(loop, nullptr, loop.getLocalTemps())) {
+                ss << "window: ";
+                for (const auto &view: window.views) {
+                    ss << symbols.offsetStridesID(*view.first) << "+" << view.second << " ";
+                }
+            }
+        }
     }
 }
 
 /* The Block list hash consists of the following fields:
  * <block_rank><SEP_BLOCK>
  */
-uint64_t block_list_hash(const std::vector<Block> &block_list, const SymbolTable &symbols) {
+uint64_t block_list_hash(const std::vector<Block> &block_list, const SymbolTable &symbols, uint64_t seed) {
     stringstream ss;
     for (const Block &b: block_list) {
         hash_stream(b, symbols, ss);
         ss << "<block>";
     }
-    return util::hash(ss.str());
+    return util::hash(ss.str(), seed);
 }
 } // Anonymous Namespace
 
-std::pair<std::string, uint64_t> CodegenCache::get(const std::vector<Block> &block_list, const SymbolTable &symbols) {
+std::pair<std::string, uint64_t> CodegenCache::get(const std::vector<Block> &block_list, const SymbolTable &symbols,
+                                                   uint64_t seed) {
     ++stat.codegen_cache_lookups;
-    const uint64_t lookup_hash = block_list_hash(block_list, symbols);
+    const uint64_t lookup_hash = block_list_hash(block_list, symbols, seed);
     auto lookup = _cache.find(lookup_hash);
     if (lookup != _cache.end()) { // Cache hit!
         return make_pair(lookup->second, lookup_hash);
@@ -113,8 +132,9 @@ std::pair<std::string, uint64_t> CodegenCache::get(const std::vector<Block> &blo
     }
 }
 
-void CodegenCache::insert(std::string source, const std::vector<Block> &block_list, const SymbolTable &symbols) {
-    const uint64_t lookup_hash = block_list_hash(block_list, symbols);
+void CodegenCache::insert(std::string source, const std::vector<Block> &block_list, const SymbolTable &symbols,
+                          uint64_t seed) {
+    const uint64_t lookup_hash = block_list_hash(block_list, symbols, seed);
     assert(_cache.find(lookup_hash) == _cache.end()); // The source shouldn't exist in the cache already
     _cache[lookup_hash] = std::move(source);
 }
@@ -19,7 +19,9 @@ If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <limits>
+#include <algorithm>
 #include <iomanip>
+#include <unistd.h>
 #include <boost/filesystem/operations.hpp>
 #include <jitk/codegen_util.hpp>
 #include <jitk/view.hpp>
@@ -63,6 +65,21 @@ boost::filesystem::path get_tmp_path(const ConfigParser &config) {
     return tmp_path / boost::filesystem::unique_path("bh_%%%%");
 }
 
+uint64_t get_streaming_store_threshold(const ConfigParser &config) {
+    const int64_t threshold = config.defaultGet<int64_t>("streaming_store_threshold", -1);
+    if (threshold != 0) {
+        return threshold < 0 ? 0 : static_cast<uint64_t>(threshold);
+    }
+    // Zero means the size of the last-level cache
+    for (int name: {_SC_LEVEL4_CACHE_SIZE, _SC_LEVEL3_CACHE_SIZE, _SC_LEVEL2_CACHE_SIZE}) {
+        const long size = sysconf(name);
+        if (size > 0) {
+            return static_cast<uint64_t>(size);
+        }
+    }
+    return 32 * 1024 * 1024; // The size is unknown
+}
+
 void create_directories(const boost::filesystem::path &path) {
     constexpr int tries = 5;
     for (int i = 1; i <= tries; ++i) {
@@ -102,5 +119,263 @@ pair<uint32_t, uint32_t> work_ranges(uint64_t work_group_size, int64_t block_siz
     return make_pair(gsize, lsize);
 }
 
+vector<size_t> kernel_temp_buffers(const vector<Block> &block_list, const vector<bh_base*> &kernel_temps) {
+    // The lifetime of each temporary is the range of top-level blocks that access it.
+    // NB: the kernel frees its temporaries at the end thus we ignore the position of BH_FREE
+    map<const bh_base*, pair<size_t, size_t> > lifetimes;
+    for (size_t i = 0; i < block_list.size(); ++i) {
+        for (const InstrPtr &instr: block_list[i].getAllInstr()) {
+            if (instr->opcode == BH_FREE) {
+                continue;
+            }
+            for (const bh_view &view: instr->operand) {
+                if (not bh_is_constant(&view)) {
+                    auto it = lifetimes.find(view.base);
+                    if (it == lifetimes.end()) {
+                        lifetimes.insert(make_pair(view.base, make_pair(i, i)));
+                    } else {
+                        it->second.second = i;
+                    }
+                }
+            }
+        }
+    }
+
+    // We assign the temporaries in the order of their first use to the first free buffer that matches
+    vector<size_t> order(kernel_temps.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return lifetimes[kernel_temps[a]].first < lifetimes[kernel_temps[b]].first;
+    });
+    vector<size_t> ret(kernel_temps.size());
+    vector<const bh_base*> buffer_types; // A temporary with the type and size of each buffer
+    vector<size_t> buffer_ends; // The last block that uses each buffer
+    for (size_t i: order) {
+        const bh_base *temp = kernel_temps[i];
+        const pair<size_t, size_t> &lifetime = lifetimes[temp];
+        size_t buffer = 0;
+        for (; buffer < buffer_types.size(); ++buffer) {
+            if (buffer_ends[buffer] < lifetime.first and buffer_types[buffer]->type == temp->type and
+                buffer_types[buffer]->nelem == temp->nelem) {
+                break;
+            }
+        }
+        if (buffer == buffer_types.size()) {
+            buffer_types.push_back(temp);
+            buffer_ends.push_back(lifetime.second);
+        } else {
+            buffer_ends[buffer] = lifetime.second;
+        }
+        ret[i] = buffer;
+    }
+    return ret;
+}
+
+vector<SlidingWindow> sliding_windows(const LoopB &block, const Scope *parent_scope, const set<bh_base*> &local_tmps,
+                                      int64_t max_window) {
+    vector<SlidingWindow> ret;
+    const int rank = block.rank;
+
+    // We have to ignore output arrays and arrays that are accumulated
+    set<const bh_base *> ignore_bases;
+    for (const InstrPtr &instr: block.getLocalInstr()) {
+        if (not instr->operand.empty()) {
+            ignore_bases.insert(instr->operand[0].base);
+        }
+        if (bh_opcode_is_accumulate(instr->opcode)) {
+            ignore_bases.insert(instr->operand[1].base);
+        }
+    }
+
+    // Group the input views by their base, strides, and offset within the innermost stride. The views of a group
+    // are shifted a whole number of iterations relative to each other.
+    // NB: the groups are in the order of their first view, which makes the kernel source deterministic
+    map<pair<const bh_base*, vector<int64_t> >, size_t> group_ids;
+    vector<set<pair<int64_t, const bh_view*> > > groups;
+    set<bh_view> candidates;
+    for (const InstrPtr &instr: block.getLocalInstr()) {
+        if (bh_opcode_is_system(instr->opcode) or instr->opcode == BH_GATHER or instr->opcode == BH_SCATTER or
+            instr->opcode == BH_COND_SCATTER) {
+            continue;
+        }
+        for (size_t o = 1; o < instr->operand.size(); ++o) {
+            const bh_view &view = instr->operand[o];
+            if (bh_is_constant(&view) or util::exist(ignore_bases, view.base) or util::exist(local_tmps, view.base) or
+                view.ndim != rank + 1 or view.stride[rank] == 0 or bh_is_scalar(&view) or
+                (parent_scope != nullptr and (parent_scope->symbols.isAlwaysArray(view.base) or
+                                              not parent_scope->isArray(view)))) {
+                continue;
+            }
+            if (not candidates.insert(view).second) {
+                continue;
+            }
+            const int64_t stride = view.stride[rank];
+            const int64_t residue = ((view.start % stride) + stride) % stride;
+            vector<int64_t> key(view.stride, view.stride + view.ndim);
+            key.push_back(residue);
+            const auto group_id = group_ids.insert(make_pair(make_pair(view.base, key), groups.size()));
+            if (group_id.second) {
+                groups.emplace_back();
+            }
+            groups[group_id.first->second].insert(make_pair((view.start - residue) / stride, &view));
+        }
+    }
+
+    // Split each group into windows of at most `max_window` variables
+    for (const set<pair<int64_t, const bh_view*> > &group: groups) {
+        SlidingWindow window;
+        int64_t first = 0;
+        for (const pair<int64_t, const bh_view*> &view: group) {
+            if (window.views.empty() or view.first - first >= max_window) {
+                if (window.views.size() > 1) {
+                    ret.push_back(window);
+                }
+                window.views.clear();
+                first = view.first;
+            }
+            window.views.push_back(make_pair(view.second, view.first - first));
+        }
+        if (window.views.size() > 1) {
+            ret.push_back(window);
+        }
+    }
+    return ret;
+}
+
+vector<const bh_view*> streamed_outputs(const SymbolTable &symbols, const LoopB &block, const Scope *parent_scope,
+                                       uint64_t threshold) {
+    vector<const bh_view*> ret, candidates;
+    if (threshold == 0 or not block.isInnermost() or not block._sweeps.empty() or block.size <= 1) {
+        return ret;
+    }
+    const set<bh_base *> &local_tmps = block.getLocalTemps();
+
+    // The first access of each array must be a write and all accesses must be through the same view
+    // NB: an instruction reads its inputs before writing its output, e.g. `a = a + b` reads `a` first
+    map<const bh_base *, const bh_view *> first_access;
+    set<const bh_base *> rejected;
+    for (const InstrPtr &instr: block.getLocalInstr()) {
+        if (bh_opcode_is_system(instr->opcode)) {
+            continue;
+        }
+        for (size_t i = 1; i <= instr->operand.size(); ++i) {
+            const size_t o = i % instr->operand.size();
+            const bh_view &view = instr->operand[o];
+            if (bh_is_constant(&view)) {
+                continue;
+            }
+            const auto access = first_access.insert(make_pair(view.base, &view));
+            if (access.second and o == 0) {
+                candidates.push_back(&view);
+            } else if (access.second or not (*access.first->second == view)) {
+                rejected.insert(view.base);
+            }
+        }
+    }
+
+    // Only contiguous arrays of at least 'threshold' bytes, which the innermost loop overwrites completely
+    for (const bh_view *view: candidates) {
+        bh_base *base = view->base;
+        if (util::exist(rejected, base) or util::exist(local_tmps, base) or symbols.isAlwaysArray(base) or
+            base->type == bh_type::BOOL or view->ndim != block.rank + 1 or not bh_is_contiguous(view) or
+            bh_nelements(*view) != base->nelem or
+            static_cast<uint64_t>(base->nelem) * bh_type_size(base->type) < threshold or
+            (parent_scope != nullptr and not parent_scope->isArray(*view))) {
+            continue;
+        }
+        ret.push_back(view);
+    }
+    return ret;
+}
+
+LoopInvariants loop_invariants(const LoopB &block, const Scope &parent_scope) {
+    LoopInvariants ret;
+    const int rank = block.rank;
+    const vector<InstrPtr> instr_list = block.getAllInstr();
+
+    // We have to ignore output arrays and arrays that are accumulated
+    set<const bh_base *> ignore_bases;
+    map<const bh_base *, int> num_writes;
+    for (const InstrPtr &instr: instr_list) {
+        if (bh_opcode_is_system(instr->opcode)) {
+            continue;
+        }
+        if (not instr->operand.empty()) {
+            ignore_bases.insert(instr->operand[0].base);
+            ++num_writes[instr->operand[0].base];
+        }
+        if (bh_opcode_is_accumulate(instr->opcode)) {
+            ignore_bases.insert(instr->operand[1].base);
+        }
+    }
+
+    // The input views that have zero strides along the axes of 'block' and its inner loops
+    set<bh_view> invariant_views;
+    for (const InstrPtr &instr: instr_list) {
+        if (bh_opcode_is_system(instr->opcode) or instr->opcode == BH_GATHER or instr->opcode == BH_SCATTER or
+            instr->opcode == BH_COND_SCATTER) {
+            continue;
+        }
+        for (size_t o = 1; o < instr->operand.size(); ++o) {
+            const bh_view &view = instr->operand[o];
+            if (bh_is_constant(&view) or util::exist(ignore_bases, view.base) or view.ndim <= rank or
+                bh_is_scalar(&view) or parent_scope.symbols.isAlwaysArray(view.base)) {
+                continue;
+            }
+            // NB: a view that the enclosing loop scalar replaces but hasn't declared yet is declared by the hoisting
+            if (not (parent_scope.isArray(view) or
+                     (parent_scope.isScalarReplaced_R(view) and not parent_scope.isDeclared(view)))) {
+                continue;
+            }
+            bool broadcast = true;
+            for (int64_t i = rank; i < view.ndim; ++i) {
+                if (view.stride[i] != 0) {
+                    broadcast = false;
+                    break;
+                }
+            }
+            if (broadcast and invariant_views.insert(view).second) {
+                ret.views.push_back(&view);
+            }
+        }
+    }
+
+    // The instructions of 'block' itself that only depend on invariants. NB: the output must be a local temporary
+    // that no other instruction writes, which makes it a scalar that the enclosing loop can declare.
+    const set<bh_base *> local_tmps = block.getLocalTemps();
+    for (const InstrPtr &instr: block.getLocalInstr()) {
+        if (bh_opcode_is_system(instr->opcode) or bh_opcode_is_sweep(instr->opcode) or instr->opcode == BH_RANGE or
+            instr->opcode == BH_RANDOM or instr->opcode == BH_RANDOM_NORMAL or instr->opcode == BH_GATHER or
+            instr->opcode == BH_SCATTER or instr->opcode == BH_COND_SCATTER) {
+            continue;
+        }
+        bh_base *output = instr->operand[0].base;
+        if (not util::exist(local_tmps, output) or parent_scope.symbols.isAlwaysArray(output) or
+            num_writes[output] != 1) {
+            continue;
+        }
+        bool invariant = true;
+        for (size_t o = 1; o < instr->operand.size(); ++o) {
+            const bh_view &view = instr->operand[o];
+            if (bh_is_constant(&view) or util::exist(invariant_views, view) or util::exist(ret.tmps, view.base)) {
+                continue;
+            }
+            // NB: the scalars that the enclosing loops have declared are invariant when 'block' doesn't write them
+            if (parent_scope.isArray(view) or not parent_scope.isDeclared(view) or
+                util::exist(ignore_bases, view.base)) {
+                invariant = false;
+                break;
+            }
+        }
+        if (invariant) {
+            ret.instrs.push_back(instr);
+            ret.tmps.insert(output);
+        }
+    }
+    return ret;
+}
+
 } // jitk
 } // bohrium
@@ -92,16 +92,6 @@ void hash_instr(const bh_instruction &instr, ViewDB &views, std::stringstream &s
     ss << SEP_INSTR;
 }
 
-// Hash of an instruction list
-size_t hash_instr_list(const vector<bh_instruction *> &instr_list) {
-    stringstream ss;
-    ViewDB views;
-    for (const bh_instruction *instr: instr_list) {
-        hash_instr(*instr, views, ss);
-    }
-    return util::hash(ss.str());
-}
-
 void update_with_origin(bh_view &view, const bh_view &origin) {
     view.base = origin.base;
 }
@@ -137,6 +127,15 @@ void update_with_origin(Block &block, const map<int64_t, const bh_instruction *>
 
 } // Anon namespace
 
+size_t hash_instr_list(const vector<bh_instruction *> &instr_list) {
+    stringstream ss;
+    ViewDB views;
+    for (const bh_instruction *instr: instr_list) {
+        hash_instr(*instr, views, ss);
+    }
+    return util::hash(ss.str());
+}
+
 pair<vector<Block>, bool> FuseCache::get(const vector<bh_instruction *> &instr_list) {
     const size_t lookup_hash = hash_instr_list(instr_list);
     ++stat.fuser_cache_lookups;
@@ -38,6 +38,28 @@ void write_sign_function(const string &operand, stringstream &out) {
     out << "((" << operand << " > 0) - (0 > " << operand << "))";
 }
 
+// Write the conversion of 'operand' of type 't1' to type 't0' when one of them is a 16-bit float type.
+// The 16-bit floats are stored as their bit pattern thus we convert through single precision.
+void write_half_conversion(bh_type t0, bh_type t1, const string &operand, stringstream &out) {
+    stringstream in;
+    if (t1 == bh_type::FLOAT16) {
+        in << "bh_float16_to_float32(" << operand << ")";
+    } else if (t1 == bh_type::BFLOAT16) {
+        in << "bh_bfloat16_to_float32(" << operand << ")";
+    } else {
+        in << "((float)" << operand << ")";
+    }
+    if (t0 == bh_type::FLOAT16) {
+        out << "bh_float32_to_float16(" << in.str() << ")";
+    } else if (t0 == bh_type::BFLOAT16) {
+        out << "bh_float32_to_bfloat16(" << in.str() << ")";
+    } else if (t0 == bh_type::BOOL) {
+        out << "(" << in.str() << " == 0 ? 0 : 1)";
+    } else {
+        out << in.str();
+    }
+}
+
 // Write opcodes that uses a different complex functions when targeting OpenCL
 void write_opcodes_with_special_opencl_complex(const bh_instruction &instr, const vector<string> &ops,
                                                stringstream &out, int opencl, const char *fname,
@@ -129,6 +151,9 @@ void write_operation(const bh_instruction &instr, const vector<string> &ops, str
             out << ops[0] << " = " << ops[0] << " < " << ops[1] << " ? " << ops[0] << " : "
                 << ops[1] << ";";
             break;
+        case BH_WHERE: // A select of two values, which the C compilers turn into a branch-free blend
+            out << ops[0] << " = " << ops[1] << " ? " << ops[2] << " : " << ops[3] << ";";
+            break;
         case BH_INVERT:
             if (instr.operand[0].base->type == bh_type::BOOL)
                 out << ops[0] << " = !" << ops[1] << ";";
@@ -267,6 +292,7 @@ void write_operation(const bh_instruction &instr, const vector<string> &ops, str
             out << ops[0] << " = " << ops[1] << ";";
             break;
         case BH_RANDOM:
+        case BH_RANDOM_NORMAL:
             out << ops[0] << " = " << ops[1] << ";";
             break;
 
@@ -436,7 +462,9 @@ void write_operation(const bh_instruction &instr, const vector<string> &ops, str
             const bh_type t0 = instr.operand_type(0);
             const bh_type t1 = instr.operand_type(1);
 
-            if (opencl and t0 == bh_type::COMPLEX64 and t1 == bh_type::COMPLEX128) {
+            if (t0 != t1 and (bh_type_is_half(t0) or bh_type_is_half(t1))) {
+                write_half_conversion(t0, t1, ops[1], out);
+            } else if (opencl and t0 == bh_type::COMPLEX64 and t1 == bh_type::COMPLEX128) {
                 out << "make_complex64((float)" << ops[1] << ".x, (float)" << ops[1] << ".y)";
             } else if (opencl and t0 == bh_type::COMPLEX128 and t1 == bh_type::COMPLEX64) {
                 out << "make_complex128((double)" << ops[1] << ".x, (double)" << ops[1] << ".y)";
@@ -561,9 +589,10 @@ void dtype_min(bh_type dtype, stringstream &out) {
 } // Anon namespace
 
 void get_name_and_subscription(const Scope &scope, const bh_view &view, stringstream &out) {
-    scope.getName(view, out);
     if (scope.isArray(view)) {
-        write_array_subscription(scope, view, out);
+        write_array_access(scope, view, out);
+    } else {
+        scope.getName(view, out);
     }
 }
 
@@ -607,14 +636,23 @@ void write_random_instr(const Scope &scope, const bh_instruction &instr, strings
     // Write output operand
     ops.push_back(get_name_and_subscription(scope, instr.operand[0]));
 
-    // Write the random generation
+    // Write the random generation, which is the raw 64 bits, uniform floats in [0, 1), or standard normals
     stringstream ss;
+    ss << "random123";
+    if (instr.opcode == BH_RANDOM_NORMAL) {
+        ss << "_normal";
+    } else if (bh_type_is_float(instr.operand_type(0))) {
+        ss << "_uniform";
+    }
+    if (bh_type_is_float(instr.operand_type(0))) {
+        ss << (instr.operand_type(0) == bh_type::FLOAT32 ? "_float32" : "_float64");
+    }
     // Find the random `start` and `key`
     const int64_t constID = scope.symbols.constID(instr);
     if (constID >= 0) {
-        ss << "random123(" << "c" << constID << ".x, " << "c" << constID << ".y, " ;
+        ss << "(" << "c" << constID << ".x, " << "c" << constID << ".y, " ;
     } else {
-        ss << "random123(" << instr.constant.value.r123.start << ", " << instr.constant.value.r123.key << ", ";
+        ss << "(" << instr.constant.value.r123.start << ", " << instr.constant.value.r123.key << ", ";
     }
 
     // Let's find the flatten index of the output view
@@ -646,10 +684,18 @@ void write_gather_instr(const Scope &scope, const bh_instruction &instr, strings
     ops.push_back(get_name_and_subscription(scope, instr.operand[0]));
 
     stringstream ss;
-    scope.getName(instr.operand[1], ss);
-    ss << "[" << instr.operand[1].start << " + ";
-    get_name_and_subscription(scope, instr.operand[2], ss);
-    ss << "]";
+    if (instr.operand[1].base->packed) {
+        ss << "BH_BIT_GET(";
+        scope.getName(instr.operand[1], ss);
+        ss << ", " << instr.operand[1].start << " + ";
+        get_name_and_subscription(scope, instr.operand[2], ss);
+        ss << ")";
+    } else {
+        scope.getName(instr.operand[1], ss);
+        ss << "[" << instr.operand[1].start << " + ";
+        get_name_and_subscription(scope, instr.operand[2], ss);
+        ss << "]";
+    }
     ops.push_back(ss.str());
 
     write_operation(instr, ops, out, opencl);
@@ -683,8 +729,7 @@ void write_accumulate_instr(const Scope &scope, const bh_instruction &instr, str
 
     // Write the previous element access, NB: this works because of loop peeling
     stringstream ss;
-    scope.getName(instr.operand[0], ss);
-    write_array_subscription(scope, instr.operand[0], ss, true, BH_MAXDIM, make_pair(instr.sweep_axis(), -1));
+    write_array_access(scope, instr.operand[0], ss, true, BH_MAXDIM, make_pair(instr.sweep_axis(), -1));
     ops.push_back(ss.str());
 
     // Write the current element access
@@ -708,18 +753,16 @@ void write_other_instr(const Scope &scope, const bh_instruction &instr, stringst
             } else {
                 instr.constant.pprint(ss, opencl);
             }
+        } else if (scope.isArray(view)) {
+            if (o == 0 and bh_opcode_is_reduction(instr.opcode) and instr.operand[1].ndim > 1) {
+                // If 'instr' is a reduction we have to ignore the reduced axis of the output array when
+                // reducing to a non-scalar
+                write_array_access(scope, view, ss, true, instr.sweep_axis());
+            } else {
+                write_array_access(scope, view, ss);
+            }
         } else {
             scope.getName(view, ss);
-
-            if (scope.isArray(view)) {
-                if (o == 0 and bh_opcode_is_reduction(instr.opcode) and instr.operand[1].ndim > 1) {
-                    // If 'instr' is a reduction we have to ignore the reduced axis of the output array when
-                    // reducing to a non-scalar
-                    write_array_subscription(scope, view, ss, true, instr.sweep_axis());
-                } else {
-                    write_array_subscription(scope, view, ss);
-                }
-            }
         }
 
         ops.push_back(ss.str());
@@ -733,11 +776,47 @@ void write_instr(const Scope &scope, const bh_instruction &instr, stringstream &
         return;
     }
 
+    // The 16-bit float types are only converted or moved, the computation on them is done in single precision
+    // by the `bcexp` filter
+    if (instr.opcode != BH_IDENTITY) {
+        const bool is_move = ((instr.opcode == BH_GATHER or instr.opcode == BH_SCATTER or
+                               instr.opcode == BH_COND_SCATTER) and instr.operand_type(0) == instr.operand_type(1)) or
+                             (instr.opcode == BH_WHERE and not bh_is_constant(&instr.operand[2]) and
+                              not bh_is_constant(&instr.operand[3]));
+        for (size_t o = 0; o < instr.operand.size(); ++o) {
+            if (bh_type_is_half(instr.operand_type(o)) and not is_move) {
+                cerr << "Instruction: " << instr << endl;
+                throw runtime_error("The 16-bit float types must be expanded to single precision (use the bcexp filter)");
+            }
+        }
+    }
+
+    // A bit-packed output element is computed into a local variable, which is then written as a single bit.
+    // NB: the engine only packs arrays written by element-wise instructions that do not read the output array.
+    if (scope.isArray(instr.operand[0]) and instr.operand[0].base->packed) {
+        const bh_view &view = instr.operand[0];
+        Scope packed_scope(scope.symbols, &scope, {view.base}, vector<const bh_view*>(), vector<const bh_view*>());
+        stringstream ss;
+        ss << "{ ";
+        packed_scope.writeDeclaration(view, "bool", ss);
+        ss << " ";
+        write_instr(packed_scope, instr, ss, opencl);
+        string body = ss.str();
+        if (not body.empty() and body.back() == '\n') {
+            body.pop_back();
+        }
+        out << body << " BH_BIT_SET(a" << scope.symbols.baseID(view.base) << ", ";
+        write_array_element_index(scope, view, out);
+        out << ", " << packed_scope.getName(view) << "); }\n";
+        return;
+    }
+
     switch(instr.opcode) {
         case BH_RANGE:
             write_range_instr(scope, instr, out, opencl);
             break;
         case BH_RANDOM:
+        case BH_RANDOM_NORMAL:
             write_random_instr(scope, instr, out, opencl);
             break;
         case BH_GATHER:
@@ -0,0 +1,175 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <map>
+#include <set>
+
+#include <bh_util.hpp>
+#include <jitk/loop_invariant.hpp>
+
+using namespace std;
+
+namespace bohrium {
+namespace jitk {
+
+namespace {
+
+// The positions in the instruction list where a base array is accessed
+struct Accesses {
+    vector<size_t> writes;
+    vector<size_t> reads;
+    vector<size_t> frees;
+};
+
+// Does 'instr' write every element of its output base array?
+bool writes_whole_base(const bh_instruction &instr) {
+    if (instr.opcode == BH_SCATTER or instr.opcode == BH_COND_SCATTER) {
+        return false;
+    }
+    const bh_view &out = instr.operand[0];
+    return bh_nelements_nbcast(&out) == out.base->nelem;
+}
+
+// Returns the input bases of 'instr'
+set<bh_base*> input_bases(const bh_instruction &instr) {
+    set<bh_base*> ret;
+    for (size_t i = 1; i < instr.operand.size(); ++i) {
+        if (not bh_is_constant(&instr.operand[i])) {
+            ret.insert(instr.operand[i].base);
+        }
+    }
+    return ret;
+}
+
+// Is 'base' defined by the hoisted instructions alone? That is, the first access in the loop body
+// is a hoisted write of the whole array, all writes are hoisted, and all the other accesses come after the writes.
+bool hoisted_definition(const vector<bh_instruction> &instr_list, const Accesses &acc, const vector<bool> &hoisted) {
+    if (acc.writes.empty()) {
+        return false;
+    }
+    for (size_t w: acc.writes) {
+        if (not hoisted[w]) {
+            return false;
+        }
+    }
+    const size_t first_write = acc.writes.front();
+    const size_t last_write = acc.writes.back();
+    if (not writes_whole_base(instr_list[first_write])) {
+        return false;
+    }
+    // NB: a read at 'first_write' means that the first write reads the value of the previous repeat
+    if (not acc.reads.empty() and acc.reads.front() <= first_write) {
+        return false;
+    }
+    for (size_t r: acc.reads) {
+        if (not hoisted[r] and r < last_write) {
+            return false;
+        }
+    }
+    for (size_t f: acc.frees) {
+        if (f < last_write) {
+            return false;
+        }
+    }
+    return true;
+}
+} // Anonymous Namespace
+
+uint64_t hoist_loop_invariants(BhIR &bhir, vector<bh_instruction> &prologue, vector<bh_instruction> &epilogue) {
+    vector<bh_instruction> &instr_list = bhir.instr_list;
+
+    // Let's find the accesses of each base array and start with all computing instructions as hoisting candidates
+    map<bh_base*, Accesses> accesses;
+    vector<bool> hoisted(instr_list.size(), false);
+    for (size_t i = 0; i < instr_list.size(); ++i) {
+        const bh_instruction &instr = instr_list[i];
+        if (instr.opcode == BH_FREE) {
+            accesses[instr.operand[0].base].frees.push_back(i);
+        } else if (instr.opcode > BH_MAX_OPCODE_ID) {
+            // An extension method might read and write any of its operands thus it is never hoisted
+            for (const bh_view &view: instr.operand) {
+                if (not bh_is_constant(&view)) {
+                    accesses[view.base].writes.push_back(i);
+                    accesses[view.base].reads.push_back(i);
+                }
+            }
+        } else if (not bh_opcode_is_system(instr.opcode) and not instr.operand.empty()) {
+            accesses[instr.operand[0].base].writes.push_back(i);
+            for (bh_base *base: input_bases(instr)) {
+                accesses[base].reads.push_back(i);
+            }
+            hoisted[i] = true;
+        }
+    }
+
+    // Then we remove candidates until all remaining candidates only depend on arrays that are either
+    // never written in the loop body or defined by other candidates
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t i = 0; i < instr_list.size(); ++i) {
+            if (not hoisted[i]) {
+                continue;
+            }
+            const bh_instruction &instr = instr_list[i];
+            bool invariant = hoisted_definition(instr_list, accesses.at(instr.operand[0].base), hoisted);
+            for (bh_base *base: input_bases(instr)) {
+                const Accesses &acc = accesses.at(base);
+                if (not (acc.writes.empty() or hoisted_definition(instr_list, acc, hoisted))) {
+                    invariant = false;
+                }
+            }
+            if (not invariant) {
+                hoisted[i] = false;
+                changed = true;
+            }
+        }
+    }
+
+    // Finally, we split the instruction list
+    set<bh_base*> hoisted_outputs;
+    uint64_t work = 0;
+    for (size_t i = 0; i < instr_list.size(); ++i) {
+        if (hoisted[i]) {
+            hoisted_outputs.insert(instr_list[i].operand[0].base);
+            const vector<int64_t> shape = instr_list[i].shape();
+            work += bh_nelements(shape.size(), &shape[0]);
+        }
+    }
+    if (hoisted_outputs.empty()) {
+        return 0;
+    }
+    vector<bh_instruction> body;
+    for (size_t i = 0; i < instr_list.size(); ++i) {
+        bh_instruction &instr = instr_list[i];
+        if (hoisted[i]) {
+            prologue.push_back(std::move(instr));
+        } else if (instr.opcode == BH_FREE and util::exist(hoisted_outputs, instr.operand[0].base)) {
+            epilogue.push_back(std::move(instr));
+        } else {
+            body.push_back(std::move(instr));
+        }
+    }
+    instr_list = std::move(body);
+    return work;
+}
+
+} // jitk
+} // bohrium
@@ -0,0 +1,184 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <map>
+#include <set>
+#include <limits>
+#include <algorithm>
+
+#include <jitk/temporal_blocking.hpp>
+
+using namespace std;
+
+namespace bohrium {
+namespace jitk {
+
+namespace {
+
+// The row offsets (relative to the iteration of the outermost loop) that a loop reads and writes of each array
+struct RowAccesses {
+    map<const bh_base*, set<int64_t> > reads;
+    map<const bh_base*, set<int64_t> > writes;
+};
+
+// Finds the row offset of 'view', which must stay within one row of 'row_stride' elements in each iteration.
+// Returns false if the view isn't row aligned.
+bool row_offset(const bh_view &view, int64_t row_stride, int64_t &offset) {
+    if (view.ndim < 1 or row_stride <= 0 or view.stride[0] != row_stride or view.start < 0) {
+        return false;
+    }
+    int64_t lo = view.start % row_stride;
+    int64_t hi = lo;
+    for (int64_t i = 1; i < view.ndim; ++i) {
+        const int64_t extent = (view.shape[i] - 1) * view.stride[i];
+        if (extent < 0) {
+            lo += extent;
+        } else {
+            hi += extent;
+        }
+    }
+    if (lo < 0 or hi >= row_stride) {
+        return false;
+    }
+    offset = view.start / row_stride;
+    return true;
+}
+
+// Returns the minimum shift of loop 'b' relative to loop 'a', which executes before 'b' in the original order.
+// Returns the lowest int64_t if 'b' doesn't depend on 'a'.
+int64_t min_relative_shift(const RowAccesses &a, const RowAccesses &b) {
+    int64_t ret = numeric_limits<int64_t>::lowest();
+    for (const auto &write: a.writes) {
+        const int64_t first_write = *write.second.begin();
+        // Flow dependencies: 'b' must read a row after 'a' wrote it
+        auto read = b.reads.find(write.first);
+        if (read != b.reads.end()) {
+            ret = std::max(ret, *read->second.rbegin() - first_write);
+        }
+        // Output dependencies: 'b' must write a row after 'a' wrote it
+        auto b_write = b.writes.find(write.first);
+        if (b_write != b.writes.end()) {
+            ret = std::max(ret, *b_write->second.rbegin() - first_write);
+        }
+    }
+    // Anti dependencies: 'b' must write a row after 'a' read it
+    for (const auto &read: a.reads) {
+        auto write = b.writes.find(read.first);
+        if (write != b.writes.end()) {
+            ret = std::max(ret, *write->second.rbegin() - *read.second.begin());
+        }
+    }
+    return ret;
+}
+} // Anonymous Namespace
+
+vector<int64_t> temporal_blocking_shifts(const vector<Block> &block_list, uint64_t nsteps) {
+    const vector<int64_t> not_possible;
+    if (nsteps < 2 or block_list.empty()) {
+        return not_possible;
+    }
+
+    // All computing blocks must be data-parallel loops over the same outermost axis
+    int64_t size = -1;
+    set<const bh_base*> written;
+    for (const Block &block: block_list) {
+        if (block.isSystemOnly()) {
+            continue;
+        }
+        if (block.isInstr()) {
+            return not_possible;
+        }
+        const LoopB &loop = block.getLoop();
+        if (loop.rank != 0 or loop.size < 2 or not loop._sweeps.empty() or (size != -1 and loop.size != size)) {
+            return not_possible;
+        }
+        size = loop.size;
+        for (const InstrPtr &instr: loop.getAllInstr()) {
+            if (bh_opcode_is_system(instr->opcode)) {
+                continue;
+            }
+            if (instr->opcode == BH_GATHER or instr->opcode == BH_SCATTER or instr->opcode == BH_COND_SCATTER) {
+                return not_possible;
+            }
+            written.insert(instr->operand[0].base);
+        }
+    }
+    if (size == -1) {
+        return not_possible;
+    }
+
+    // Let's find the row accesses of each block. Only arrays written within the block list matters.
+    // NB: all views of an array must agree on the row stride
+    map<const bh_base*, int64_t> row_strides;
+    vector<RowAccesses> accesses(block_list.size());
+    for (size_t j = 0; j < block_list.size(); ++j) {
+        if (block_list[j].isInstr() or block_list[j].isSystemOnly()) {
+            continue;
+        }
+        for (const InstrPtr &instr: block_list[j].getLoop().getAllInstr()) {
+            if (bh_opcode_is_system(instr->opcode)) {
+                continue;
+            }
+            for (size_t o = 0; o < instr->operand.size(); ++o) {
+                const bh_view &view = instr->operand[o];
+                if (bh_is_constant(&view) or written.find(view.base) == written.end()) {
+                    continue;
+                }
+                if (view.ndim < 1) {
+                    return not_possible;
+                }
+                auto row_stride = row_strides.insert(make_pair(view.base, view.stride[0])).first->second;
+                int64_t offset;
+                if (not row_offset(view, row_stride, offset)) {
+                    return not_possible;
+                }
+                if (o == 0) {
+                    accesses[j].writes[view.base].insert(offset);
+                } else {
+                    accesses[j].reads[view.base].insert(offset);
+                }
+            }
+        }
+    }
+
+    // Finally, we find the smallest shifts that preserve the dependencies between all the loop instances
+    const size_t nblocks = block_list.size();
+    vector<int64_t> shifts(nsteps * nblocks, -1);
+    for (size_t b = 0; b < shifts.size(); ++b) {
+        if (block_list[b % nblocks].isInstr() or block_list[b % nblocks].isSystemOnly()) {
+            continue;
+        }
+        int64_t shift = 0;
+        for (size_t a = 0; a < b; ++a) {
+            if (shifts[a] == -1) {
+                continue;
+            }
+            const int64_t relative = min_relative_shift(accesses[a % nblocks], accesses[b % nblocks]);
+            if (relative != numeric_limits<int64_t>::lowest()) {
+                shift = std::max(shift, shifts[a] + relative);
+            }
+        }
+        shifts[b] = shift;
+    }
+    return shifts;
+}
+
+} // jitk
+} // bohrium
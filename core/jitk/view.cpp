@@ -28,8 +28,47 @@ using namespace std;
 namespace bohrium {
 namespace jitk {
 
+namespace {
+// Write the term of 'axis' in the index of 'view', e.g. " +i2*10"
+void write_axis_term(const Scope &scope, const bh_view &view, int axis, stringstream &out) {
+    if (scope.symbols.strides_as_var and scope.symbols.existOffsetStridesID(view)) {
+        out << " +i" << axis << "*vs" << scope.symbols.offsetStridesID(view) << "_" << axis;
+    } else if (view.stride[axis] != 0) {
+        out << " +i" << axis;
+        if (view.stride[axis] != 1) {
+            out << "*" << view.stride[axis];
+        }
+    }
+}
+
+// Check if the index of 'view' can be written as a declared offset plus the terms of the inner loops
+bool use_declared_offset(const Scope &scope, const bh_view &view, int hidden_axis, const pair<int, int> axis_offset) {
+    return hidden_axis == BH_MAXDIM and axis_offset.first == BH_MAXDIM and not bh_is_scalar(&view) and
+           scope.offsetRank(view) >= 0;
+}
+} // Anon namespace
+
+void write_array_offset(const Scope &scope, const bh_view &view, int rank, stringstream &out) {
+    const int declared_rank = scope.offsetRank(view);
+    assert(declared_rank <= rank);
+    if (declared_rank >= 0) {
+        scope.getOffsetName(view, declared_rank, out);
+    } else if (scope.symbols.strides_as_var and scope.symbols.existOffsetStridesID(view)) {
+        out << "vo" << scope.symbols.offsetStridesID(view);
+    } else {
+        out << view.start;
+    }
+    for (int i = declared_rank + 1; i <= rank; ++i) {
+        write_axis_term(scope, view, i, out);
+    }
+}
+
 void write_array_index(const Scope &scope, const bh_view &view, stringstream &out,
                        int hidden_axis, const pair<int, int> axis_offset) {
+    if (use_declared_offset(scope, view, hidden_axis, axis_offset)) {
+        write_array_offset(scope, view, view.ndim - 1, out);
+        return;
+    }
     bool empty_subscription = true;
     if (view.start > 0) {
         out << view.start;
@@ -59,6 +98,10 @@ void write_array_index(const Scope &scope, const bh_view &view, stringstream &ou
 
 void write_array_index_variables(const Scope &scope, const bh_view &view, stringstream &out,
                                  int hidden_axis, const pair<int, int> axis_offset) {
+    if (use_declared_offset(scope, view, hidden_axis, axis_offset)) {
+        write_array_offset(scope, view, view.ndim - 1, out);
+        return;
+    }
 
     // Write view.start using the offset-and-strides variable
     out << "vo" << scope.symbols.offsetStridesID(view);
@@ -101,6 +144,37 @@ void write_array_subscription(const Scope &scope, const bh_view &view, stringstr
     out << "]";
 }
 
+void write_array_access(const Scope &scope, const bh_view &view, stringstream &out, bool ignore_declared_indexes,
+                        int hidden_axis, const pair<int, int> axis_offset) {
+    stringstream ss;
+    write_array_subscription(scope, view, ss, ignore_declared_indexes, hidden_axis, axis_offset);
+    if (view.base->packed) {
+        const string subscription = ss.str();
+        out << "BH_BIT_GET(a" << scope.symbols.baseID(view.base) << ", "
+            << subscription.substr(1, subscription.size() - 2) << ")";
+    } else {
+        out << "a" << scope.symbols.baseID(view.base) << ss.str();
+    }
+}
+
+void write_hoisted_array_access(const Scope &scope, const bh_view &view, int rank, stringstream &out) {
+    stringstream ss;
+    write_array_offset(scope, view, rank, ss);
+    if (view.base->packed) {
+        out << "BH_BIT_GET(a" << scope.symbols.baseID(view.base) << ", " << ss.str() << ")";
+    } else {
+        out << "a" << scope.symbols.baseID(view.base) << "[" << ss.str() << "]";
+    }
+}
+
+void write_array_element_index(const Scope &scope, const bh_view &view, stringstream &out,
+                               bool ignore_declared_indexes) {
+    stringstream ss;
+    write_array_subscription(scope, view, ss, ignore_declared_indexes, BH_MAXDIM, make_pair(BH_MAXDIM, 0));
+    const string subscription = ss.str();
+    out << subscription.substr(1, subscription.size() - 2);
+}
+
 } // jitk
 } // bohrium
 
@@ -0,0 +1,149 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <bh_type.hpp>
+
+namespace bohrium {
+namespace extmethod {
+
+/* The arithmetic of the native extension methods where elements of type T are loaded into the accumulator
+ * type `acc`, multiplied and added, and stored back as type T. */
+template <typename T, bool INTEGER = std::is_integral<T>::value>
+struct Arith {
+    typedef T acc;
+    static acc zero() { return acc(0); }
+    static acc load(T value) { return value; }
+    static T store(acc value) { return value; }
+    static void madd(acc &c, acc a, acc b) { c += a * b; }
+    static void add(acc &c, acc a) { c += a; }
+};
+
+// Integers wrap around on overflow like NumPy, thus we compute in an unsigned type of at least the size of `int`
+template <typename T>
+struct Arith<T, true> {
+    typedef T acc;
+    typedef typename std::common_type<typename std::make_unsigned<T>::type, unsigned>::type U;
+    static acc zero() { return acc(0); }
+    static acc load(T value) { return value; }
+    static T store(acc value) { return value; }
+    static void madd(acc &c, acc a, acc b) { c = static_cast<T>(U(c) + U(a) * U(b)); }
+    static void add(acc &c, acc a) { c = static_cast<T>(U(c) + U(a)); }
+};
+
+// Booleans multiply with logical and and add with logical or
+struct BoolArith {
+    typedef bh_bool acc;
+    static acc zero() { return 0; }
+    static acc load(bh_bool value) { return value != 0; }
+    static bh_bool store(acc value) { return value; }
+    static void madd(acc &c, acc a, acc b) { c |= a & b; }
+    static void add(acc &c, acc a) { c |= a; }
+};
+
+// Complex numbers are multiplied component-wise, which the compiler can vectorize
+template <typename C>
+struct ComplexArith {
+    typedef C acc;
+    static acc zero() { return acc{0, 0}; }
+    static acc load(C value) { return value; }
+    static C store(acc value) { return value; }
+    static void madd(acc &c, acc a, acc b) {
+        c.real += a.real * b.real - a.imag * b.imag;
+        c.imag += a.real * b.imag + a.imag * b.real;
+    }
+    static void add(acc &c, acc a) {
+        c.real += a.real;
+        c.imag += a.imag;
+    }
+};
+
+// Half precision types are computed in single precision
+template <typename H, float (*TO_FLOAT)(H), H (*FROM_FLOAT)(float)>
+struct HalfArith {
+    typedef float acc;
+    static acc zero() { return 0; }
+    static acc load(H value) { return TO_FLOAT(value); }
+    static H store(acc value) { return FROM_FLOAT(value); }
+    static void madd(acc &c, acc a, acc b) { c += a * b; }
+    static void add(acc &c, acc a) { c += a; }
+};
+
+// Calls `KERNEL<T, ARITH>::run(args...)` where T is the element type of `type` and ARITH is its arithmetic.
+// Throws when `type` isn't supported by the extension method `name`.
+template <template <typename, typename> class KERNEL, typename... ARGS>
+void dispatch_arith(const std::string &name, bh_type type, ARGS&&... args) {
+    switch (type) {
+        case bh_type::BOOL:
+            KERNEL<bh_bool, BoolArith>::run(args...);
+            break;
+        case bh_type::INT8:
+            KERNEL<bh_int8, Arith<bh_int8> >::run(args...);
+            break;
+        case bh_type::INT16:
+            KERNEL<bh_int16, Arith<bh_int16> >::run(args...);
+            break;
+        case bh_type::INT32:
+            KERNEL<bh_int32, Arith<bh_int32> >::run(args...);
+            break;
+        case bh_type::INT64:
+            KERNEL<bh_int64, Arith<bh_int64> >::run(args...);
+            break;
+        case bh_type::UINT8:
+            KERNEL<bh_uint8, Arith<bh_uint8> >::run(args...);
+            break;
+        case bh_type::UINT16:
+            KERNEL<bh_uint16, Arith<bh_uint16> >::run(args...);
+            break;
+        case bh_type::UINT32:
+            KERNEL<bh_uint32, Arith<bh_uint32> >::run(args...);
+            break;
+        case bh_type::UINT64:
+            KERNEL<bh_uint64, Arith<bh_uint64> >::run(args...);
+            break;
+        case bh_type::FLOAT32:
+            KERNEL<bh_float32, Arith<bh_float32> >::run(args...);
+            break;
+        case bh_type::FLOAT64:
+            KERNEL<bh_float64, Arith<bh_float64> >::run(args...);
+            break;
+        case bh_type::COMPLEX64:
+            KERNEL<bh_complex64, ComplexArith<bh_complex64> >::run(args...);
+            break;
+        case bh_type::COMPLEX128:
+            KERNEL<bh_complex128, ComplexArith<bh_complex128> >::run(args...);
+            break;
+        case bh_type::FLOAT16:
+            KERNEL<bh_float16, HalfArith<bh_float16, bh_float16_to_float32, bh_float32_to_float16> >::run(args...);
+            break;
+        case bh_type::BFLOAT16:
+            KERNEL<bh_bfloat16, HalfArith<bh_bfloat16, bh_bfloat16_to_float32, bh_float32_to_bfloat16> >::run(
+                    args...);
+            break;
+        default:
+            throw std::runtime_error(name + ": unsupported type " + bh_type_text(type));
+    }
+}
+
+}} //namespace bohrium::extmethod
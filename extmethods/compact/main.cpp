@@ -0,0 +1,222 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <omp.h>
+
+#include <bh_extmethod.hpp>
+
+using namespace bohrium;
+using namespace extmethod;
+using namespace std;
+
+namespace {
+
+// The offsets of the elements of a view in row-major order
+class ElementOffsets {
+private:
+    const bh_view &_view;
+    const bool _contiguous;
+public:
+    explicit ElementOffsets(const bh_view &view) : _view(view), _contiguous(bh_is_contiguous(&view)) {}
+
+    // The offset of the i'th element
+    int64_t operator()(int64_t i) const {
+        if (_contiguous) {
+            return _view.start + i;
+        }
+        int64_t offset = _view.start;
+        for (int64_t d = _view.ndim - 1; d >= 0; --d) {
+            offset += (i % _view.shape[d]) * _view.stride[d];
+            i /= _view.shape[d];
+        }
+        return offset;
+    }
+};
+
+/* Parallel stream compaction of the elements selected by 'mask':
+ *   1) each thread counts the selected elements in its chunk of the mask,
+ *   2) an exclusive prefix sum of the counts gives the output position of each chunk, and
+ *   3) each thread calls `write(i, pos)` for each selected element `i` in its chunk where `pos` is the
+ *      position of the element in the output.
+ * Positions beyond `max_pos` are not written. Returns the number of selected elements.
+ */
+template <typename Write>
+int64_t compact(const bh_view &mask, int64_t max_pos, Write write) {
+    const int64_t nelem = bh_nelements(mask);
+    const bool *m = static_cast<const bool *>(mask.base->data);
+    const ElementOffsets offset(mask);
+    vector<int64_t> counts(omp_get_max_threads() + 1, 0);
+
+    #pragma omp parallel
+    {
+        const int64_t tid = omp_get_thread_num();
+        const int64_t chunk = (nelem + omp_get_num_threads() - 1) / omp_get_num_threads();
+        const int64_t begin = std::min(nelem, tid * chunk);
+        const int64_t end = std::min(nelem, begin + chunk);
+
+        int64_t count = 0;
+        for (int64_t i = begin; i < end; ++i) {
+            count += m[offset(i)] ? 1 : 0;
+        }
+        counts[tid + 1] = count;
+
+        #pragma omp barrier
+        #pragma omp single
+        for (size_t t = 1; t < counts.size(); ++t) {
+            counts[t] += counts[t - 1];
+        }
+
+        int64_t pos = counts[tid];
+        for (int64_t i = begin; i < end and pos < max_pos; ++i) {
+            if (m[offset(i)]) {
+                write(i, pos++);
+            }
+        }
+    }
+    return counts.back();
+}
+
+// Check the mask and output operands, which are shared by all compactions
+void check_operands(const bh_view &out, const bh_view &mask, const char *name) {
+    if (mask.base->type != bh_type::BOOL) {
+        throw runtime_error(string(name) + ": the mask must be a boolean array");
+    }
+    if (not bh_is_contiguous(&out)) {
+        throw runtime_error(string(name) + ": the output must be contiguous");
+    }
+}
+
+// Check that the size of the output matches the number of selected elements
+void check_count(const bh_view &out, int64_t count, const char *name) {
+    if (count != bh_nelements(out)) {
+        throw runtime_error(string(name) + ": " + to_string(count) + " elements are selected but the output has " +
+                            to_string(bh_nelements(out)) + " elements");
+    }
+}
+
+// compact: OUT = IN[MASK] where OUT is a contiguous 1-D array of the selected elements of IN in row-major order
+class CompactImpl : public ExtmethodImpl {
+private:
+    template <size_t ELEM_SIZE>
+    int64_t compact_elements(const bh_view &out, const bh_view &in, const bh_view &mask) const {
+        char *o = static_cast<char *>(out.base->data) + out.start * ELEM_SIZE;
+        const char *a = static_cast<const char *>(in.base->data);
+        const ElementOffsets offset(in);
+        return compact(mask, bh_nelements(out), [&](int64_t i, int64_t pos) {
+            memcpy(o + pos * ELEM_SIZE, a + offset(i) * ELEM_SIZE, ELEM_SIZE);
+        });
+    }
+
+public:
+    void execute(bh_instruction *instr, void *arg) {
+        const bh_view &out = instr->operand[0];
+        const bh_view &in = instr->operand[1];
+        const bh_view &mask = instr->operand[2];
+        check_operands(out, mask, "compact");
+        if (out.base->type != in.base->type) {
+            throw runtime_error("compact: the input and output must have the same type");
+        }
+        if (bh_nelements(in) != bh_nelements(mask)) {
+            throw runtime_error("compact: the input and mask must have the same number of elements");
+        }
+
+        // Make sure that the arrays memory are allocated.
+        bh_data_malloc(out.base);
+        bh_data_malloc(in.base);
+        bh_data_malloc(mask.base);
+
+        int64_t count;
+        switch (bh_type_size(out.base->type)) {
+            case 1:
+                count = compact_elements<1>(out, in, mask);
+                break;
+            case 2:
+                count = compact_elements<2>(out, in, mask);
+                break;
+            case 4:
+                count = compact_elements<4>(out, in, mask);
+                break;
+            case 8:
+                count = compact_elements<8>(out, in, mask);
+                break;
+            case 16:
+                count = compact_elements<16>(out, in, mask);
+                break;
+            default:
+                throw runtime_error("compact: unsupported element size");
+        }
+        check_count(out, count, "compact");
+    }
+};
+
+// flatnonzero: OUT = indices of the true elements of MASK in row-major order. The third operand is ignored.
+class FlatnonzeroImpl : public ExtmethodImpl {
+private:
+    template <typename T>
+    int64_t indices(const bh_view &out, const bh_view &mask) const {
+        T *o = static_cast<T *>(out.base->data) + out.start;
+        return compact(mask, bh_nelements(out), [&](int64_t i, int64_t pos) {
+            o[pos] = static_cast<T>(i);
+        });
+    }
+
+public:
+    void execute(bh_instruction *instr, void *arg) {
+        const bh_view &out = instr->operand[0];
+        const bh_view &mask = instr->operand[1];
+        check_operands(out, mask, "flatnonzero");
+
+        // Make sure that the arrays memory are allocated.
+        bh_data_malloc(out.base);
+        bh_data_malloc(mask.base);
+
+        int64_t count;
+        switch (out.base->type) {
+            case bh_type::UINT64:
+                count = indices<uint64_t>(out, mask);
+                break;
+            case bh_type::INT64:
+                count = indices<int64_t>(out, mask);
+                break;
+            default:
+                throw runtime_error("flatnonzero: the output must be of type int64 or uint64");
+        }
+        check_count(out, count, "flatnonzero");
+    }
+};
+} // Unnamed namespace
+
+extern "C" ExtmethodImpl* compact_create() {
+    return new CompactImpl();
+}
+extern "C" void compact_destroy(ExtmethodImpl* self) {
+    delete self;
+}
+
+extern "C" ExtmethodImpl* flatnonzero_create() {
+    return new FlatnonzeroImpl();
+}
+extern "C" void flatnonzero_destroy(ExtmethodImpl* self) {
+    delete self;
+}
@@ -0,0 +1,155 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <omp.h>
+
+#include <bh_extmethod.hpp>
+
+#include "../arith.hpp"
+
+using namespace bohrium;
+using namespace extmethod;
+using namespace std;
+
+namespace {
+
+// The number of consecutive output elements of a row that are accumulated in a buffer while
+// iterating over all the filter taps
+constexpr int64_t TILE = 512;
+
+/* OUT[p] = sum_k IN[p + k] * FILTER[k] where `p` and `k` are N-D indices. Each thread computes tiles of
+ * TILE consecutive elements of an output row and accumulates all filter taps in a buffer such that
+ * the inner loop is a loop over a row of the input. */
+template <typename T, typename ARITH>
+void correlate(const bh_view &out, const bh_view &in, const bh_view &filter) {
+    typedef typename ARITH::acc Acc;
+    const int64_t nd = out.ndim;
+    const int64_t ncols = out.shape[nd - 1];
+    const int64_t nrows = bh_nelements(out) / ncols;
+    const int64_t ntiles = (ncols + TILE - 1) / TILE;
+    const int64_t o_cs = out.stride[nd - 1];
+    const int64_t i_cs = in.stride[nd - 1];
+
+    T *o = static_cast<T *>(out.base->data);
+    const T *a = static_cast<const T *>(in.base->data);
+    const T *f = static_cast<const T *>(filter.base->data);
+
+    // The offset into the input and the coefficient of each filter tap
+    vector<pair<int64_t, Acc> > taps;
+    const int64_t ntaps = bh_nelements(filter);
+    taps.reserve(ntaps);
+    for (int64_t t = 0; t < ntaps; ++t) {
+        int64_t in_offset = 0, filter_offset = filter.start, idx = t;
+        for (int64_t d = nd - 1; d >= 0; --d) {
+            const int64_t k = idx % filter.shape[d];
+            in_offset += k * in.stride[d];
+            filter_offset += k * filter.stride[d];
+            idx /= filter.shape[d];
+        }
+        taps.push_back(make_pair(in_offset, ARITH::load(f[filter_offset])));
+    }
+
+    #pragma omp parallel
+    {
+        vector<Acc> acc(TILE);
+
+        #pragma omp for schedule(static)
+        for (int64_t tile = 0; tile < nrows * ntiles; ++tile) {
+            const int64_t row = tile / ntiles;
+            const int64_t j0 = tile % ntiles * TILE;
+            const int64_t nj = std::min(TILE, ncols - j0);
+
+            // The offsets of the first element of the tile in the output and input
+            int64_t o_offset = out.start + j0 * o_cs, i_offset = in.start + j0 * i_cs, idx = row;
+            for (int64_t d = nd - 2; d >= 0; --d) {
+                o_offset += (idx % out.shape[d]) * out.stride[d];
+                i_offset += (idx % out.shape[d]) * in.stride[d];
+                idx /= out.shape[d];
+            }
+
+            std::fill(acc.begin(), acc.begin() + nj, ARITH::zero());
+            for (const auto &tap: taps) {
+                const T *a_row = a + i_offset + tap.first;
+                const Acc coef = tap.second;
+                #pragma omp simd
+                for (int64_t j = 0; j < nj; ++j) {
+                    ARITH::madd(acc[j], ARITH::load(a_row[j * i_cs]), coef);
+                }
+            }
+            for (int64_t j = 0; j < nj; ++j) {
+                o[o_offset + j * o_cs] = ARITH::store(acc[j]);
+            }
+        }
+    }
+}
+
+template <typename T, typename ARITH>
+struct Correlate {
+    static void run(const bh_view &out, const bh_view &in, const bh_view &filter) {
+        correlate<T, ARITH>(out, in, filter);
+    }
+};
+
+// correlate: OUT = IN correlated with FILTER in 'valid' mode thus OUT.shape == IN.shape - FILTER.shape + 1
+class CorrelateImpl : public ExtmethodImpl {
+public:
+    void execute(bh_instruction *instr, void *arg) {
+        const bh_view &out = instr->operand[0];
+        const bh_view &in = instr->operand[1];
+        const bh_view &filter = instr->operand[2];
+
+        if (out.base->type != in.base->type or out.base->type != filter.base->type) {
+            throw runtime_error("correlate: the inputs and output must have the same type");
+        }
+        const int64_t nd = out.ndim;
+        if (in.ndim != nd or filter.ndim != nd) {
+            throw runtime_error("correlate: the inputs and output must have the same number of dimensions");
+        }
+        for (int64_t d = 0; d < nd; ++d) {
+            if (filter.shape[d] < 1 or out.shape[d] != in.shape[d] - filter.shape[d] + 1) {
+                stringstream ss;
+                ss << "correlate: the shape of the output must be the shape of the input minus the shape of the "
+                      "filter plus one, cannot correlate " << in << " with " << filter << " into " << out;
+                throw runtime_error(ss.str());
+            }
+        }
+        if (bh_nelements(out) == 0) {
+            return;
+        }
+
+        // Make sure that the arrays memory are allocated.
+        bh_data_malloc(out.base);
+        bh_data_malloc(in.base);
+        bh_data_malloc(filter.base);
+
+        dispatch_arith<Correlate>("correlate", out.base->type, out, in, filter);
+    }
+};
+} // Unnamed namespace
+
+extern "C" ExtmethodImpl* correlate_create() {
+    return new CorrelateImpl();
+}
+extern "C" void correlate_destroy(ExtmethodImpl* self) {
+    delete self;
+}
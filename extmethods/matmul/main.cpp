@@ -0,0 +1,190 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <omp.h>
+
+#include <bh_extmethod.hpp>
+
+#include "../arith.hpp"
+
+using namespace bohrium;
+using namespace extmethod;
+using namespace std;
+
+namespace {
+
+// The sizes of the blocks that each thread packs into contiguous buffers: a MC×KC block of A, a KC×NC block
+// of B, and the MC×NC block of the result that they update.
+constexpr int64_t MC = 64;
+constexpr int64_t KC = 256;
+constexpr int64_t NC = 256;
+
+// The offset of the matrix number `batch` in a view where the two last axes are the matrix rows and columns
+int64_t batch_offset(const bh_view &view, int64_t batch) {
+    int64_t offset = view.start;
+    for (int64_t d = view.ndim - 3; d >= 0; --d) {
+        offset += (batch % view.shape[d]) * view.stride[d];
+        batch /= view.shape[d];
+    }
+    return offset;
+}
+
+/* OUT = A @ B where each thread computes MC×NC blocks of OUT. The blocks of A and B are packed into
+ * contiguous buffers such that the inner loop is a unit-stride loop over a row of B and OUT. */
+template <typename T, typename ARITH>
+void matmul(const bh_view &out, const bh_view &a, const bh_view &b) {
+    typedef typename ARITH::acc Acc;
+    const int64_t nd = out.ndim;
+    const int64_t M = out.shape[nd - 2];
+    const int64_t N = out.shape[nd - 1];
+    const int64_t K = a.shape[nd - 1];
+    const int64_t nbatches = bh_nelements(out) / (M * N);
+    const int64_t mblocks = (M + MC - 1) / MC;
+    const int64_t nblocks = (N + NC - 1) / NC;
+
+    T *o = static_cast<T *>(out.base->data);
+    const T *pa = static_cast<const T *>(a.base->data);
+    const T *pb = static_cast<const T *>(b.base->data);
+    const int64_t o_rs = out.stride[nd - 2], o_cs = out.stride[nd - 1];
+    const int64_t a_rs = a.stride[nd - 2], a_cs = a.stride[nd - 1];
+    const int64_t b_rs = b.stride[nd - 2], b_cs = b.stride[nd - 1];
+
+    #pragma omp parallel
+    {
+        vector<Acc> a_pack(MC * KC), b_pack(KC * NC), c_block(MC * NC);
+
+        #pragma omp for schedule(dynamic)
+        for (int64_t block = 0; block < nbatches * mblocks * nblocks; ++block) {
+            const int64_t batch = block / (mblocks * nblocks);
+            const int64_t i0 = (block / nblocks) % mblocks * MC;
+            const int64_t j0 = block % nblocks * NC;
+            const int64_t mc = std::min(MC, M - i0);
+            const int64_t nc = std::min(NC, N - j0);
+            const T *a_mat = pa + batch_offset(a, batch);
+            const T *b_mat = pb + batch_offset(b, batch);
+            T *o_mat = o + batch_offset(out, batch);
+
+            std::fill(c_block.begin(), c_block.begin() + mc * nc, ARITH::zero());
+            for (int64_t k0 = 0; k0 < K; k0 += KC) {
+                const int64_t kc = std::min(KC, K - k0);
+                for (int64_t i = 0; i < mc; ++i) {
+                    for (int64_t k = 0; k < kc; ++k) {
+                        a_pack[i * kc + k] = ARITH::load(a_mat[(i0 + i) * a_rs + (k0 + k) * a_cs]);
+                    }
+                }
+                for (int64_t k = 0; k < kc; ++k) {
+                    for (int64_t j = 0; j < nc; ++j) {
+                        b_pack[k * nc + j] = ARITH::load(b_mat[(k0 + k) * b_rs + (j0 + j) * b_cs]);
+                    }
+                }
+                for (int64_t i = 0; i < mc; ++i) {
+                    Acc *c_row = &c_block[i * nc];
+                    const Acc *a_row = &a_pack[i * kc];
+                    int64_t k = 0;
+                    // Four rows of B at a time such that each element of C is loaded and stored once per four
+                    // multiply-adds, which are still added in the order of `k`
+                    for (; k + 4 <= kc; k += 4) {
+                        const Acc a0 = a_row[k], a1 = a_row[k + 1], a2 = a_row[k + 2], a3 = a_row[k + 3];
+                        const Acc *b0 = &b_pack[k * nc];
+                        const Acc *b1 = b0 + nc, *b2 = b1 + nc, *b3 = b2 + nc;
+                        #pragma omp simd
+                        for (int64_t j = 0; j < nc; ++j) {
+                            Acc c = c_row[j];
+                            ARITH::madd(c, a0, b0[j]);
+                            ARITH::madd(c, a1, b1[j]);
+                            ARITH::madd(c, a2, b2[j]);
+                            ARITH::madd(c, a3, b3[j]);
+                            c_row[j] = c;
+                        }
+                    }
+                    for (; k < kc; ++k) {
+                        const Acc a_ik = a_row[k];
+                        const Acc *b_row = &b_pack[k * nc];
+                        #pragma omp simd
+                        for (int64_t j = 0; j < nc; ++j) {
+                            ARITH::madd(c_row[j], a_ik, b_row[j]);
+                        }
+                    }
+                }
+            }
+            for (int64_t i = 0; i < mc; ++i) {
+                for (int64_t j = 0; j < nc; ++j) {
+                    o_mat[(i0 + i) * o_rs + (j0 + j) * o_cs] = ARITH::store(c_block[i * nc + j]);
+                }
+            }
+        }
+    }
+}
+
+template <typename T, typename ARITH>
+struct Matmul {
+    static void run(const bh_view &out, const bh_view &a, const bh_view &b) { matmul<T, ARITH>(out, a, b); }
+};
+
+// matmul: OUT[..., M, N] = IN1[..., M, K] @ IN2[..., K, N] where the leading axes are a batch of matrices
+class MatmulImpl : public ExtmethodImpl {
+public:
+    void execute(bh_instruction *instr, void *arg) {
+        const bh_view &out = instr->operand[0];
+        const bh_view &a = instr->operand[1];
+        const bh_view &b = instr->operand[2];
+
+        if (out.base->type != a.base->type or out.base->type != b.base->type) {
+            throw runtime_error("matmul: the inputs and output must have the same type");
+        }
+        const int64_t nd = out.ndim;
+        if (nd < 2 or a.ndim != nd or b.ndim != nd) {
+            throw runtime_error("matmul: the inputs and output must have the same number of dimensions (at least two)");
+        }
+        for (int64_t d = 0; d < nd - 2; ++d) {
+            if (a.shape[d] != out.shape[d] or b.shape[d] != out.shape[d]) {
+                throw runtime_error("matmul: the inputs and output must have the same batch shape");
+            }
+        }
+        if (a.shape[nd - 2] != out.shape[nd - 2] or b.shape[nd - 1] != out.shape[nd - 1] or
+            a.shape[nd - 1] != b.shape[nd - 2]) {
+            stringstream ss;
+            ss << "matmul: the shapes of the matrices doesn't match, cannot multiply " << a << " and " << b
+               << " into " << out;
+            throw runtime_error(ss.str());
+        }
+        if (bh_nelements(out) == 0) {
+            return;
+        }
+
+        // Make sure that the arrays memory are allocated.
+        bh_data_malloc(out.base);
+        bh_data_malloc(a.base);
+        bh_data_malloc(b.base);
+
+        dispatch_arith<Matmul>("matmul", out.base->type, out, a, b);
+    }
+};
+} // Unnamed namespace
+
+extern "C" ExtmethodImpl* matmul_create() {
+    return new MatmulImpl();
+}
+extern "C" void matmul_destroy(ExtmethodImpl* self) {
+    delete self;
+}
@@ -0,0 +1,431 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <omp.h>
+
+#include <bh_extmethod.hpp>
+
+using namespace bohrium;
+using namespace extmethod;
+using namespace std;
+
+namespace {
+
+// When there are fewer rows than threads, rows with at least this many elements are sorted by all threads
+constexpr int64_t PARALLEL_ROW_SIZE = 1 << 16;
+
+// Maps a floating point value to an unsigned integer key with the same order. NaNs are ordered last.
+template <typename K, typename F>
+K float_key(F value) {
+    if (std::isnan(value)) {
+        return numeric_limits<K>::max();
+    }
+    if (value == 0) {
+        value = 0; // -0.0 and 0.0 are equal
+    }
+    K bits;
+    memcpy(&bits, &value, sizeof(bits));
+    const K sign = K(1) << (sizeof(K) * 8 - 1);
+    return (bits & sign) ? ~bits : bits | sign;
+}
+
+// Maps a value to an unsigned integer key with the same order, which the radix sort sorts by
+template <typename T, typename Enable = void>
+struct RadixKey;
+
+template <typename T>
+struct RadixKey<T, typename enable_if<is_integral<T>::value>::type> {
+    typedef typename make_unsigned<T>::type type;
+    static type get(T value) {
+        type key = static_cast<type>(value);
+        if (is_signed<T>::value) {
+            key ^= type(1) << (sizeof(type) * 8 - 1); // Flip the sign bit
+        }
+        return key;
+    }
+};
+
+template <>
+struct RadixKey<bh_float32> {
+    typedef uint32_t type;
+    static type get(bh_float32 value) { return float_key<type>(value); }
+};
+
+template <>
+struct RadixKey<bh_float64> {
+    typedef uint64_t type;
+    static type get(bh_float64 value) { return float_key<type>(value); }
+};
+
+template <>
+struct RadixKey<bh_float16> {
+    typedef uint32_t type;
+    static type get(bh_float16 value) { return float_key<type>(bh_float16_to_float32(value)); }
+};
+
+template <>
+struct RadixKey<bh_bfloat16> {
+    typedef uint32_t type;
+    static type get(bh_bfloat16 value) { return float_key<type>(bh_bfloat16_to_float32(value)); }
+};
+
+// Stable LSD radix sort of 'keys' and 'idx' by 8-bit digits
+template <typename K>
+void radix_sort(vector<K> &keys, vector<int64_t> &idx) {
+    const int64_t n = keys.size();
+    vector<K> tmp_keys(n);
+    vector<int64_t> tmp_idx(n);
+    for (size_t shift = 0; shift < sizeof(K) * 8; shift += 8) {
+        int64_t count[256] = {0};
+        for (int64_t i = 0; i < n; ++i) {
+            ++count[(keys[i] >> shift) & 0xFF];
+        }
+        if (*max_element(count, count + 256) == n) {
+            continue; // All keys have the same digit
+        }
+        int64_t offset = 0;
+        for (int64_t &c: count) {
+            const int64_t t = c;
+            c = offset;
+            offset += t;
+        }
+        for (int64_t i = 0; i < n; ++i) {
+            const int64_t pos = count[(keys[i] >> shift) & 0xFF]++;
+            tmp_keys[pos] = keys[i];
+            tmp_idx[pos] = idx[i];
+        }
+        keys.swap(tmp_keys);
+        idx.swap(tmp_idx);
+    }
+}
+
+// Parallel stable LSD radix sort where each thread histograms and scatters its chunk of the keys. The chunks
+// of a digit are written in thread order, which keeps the sort stable.
+template <typename K>
+void parallel_radix_sort(vector<K> &keys, vector<int64_t> &idx) {
+    const int64_t n = keys.size();
+    const int64_t nchunks = omp_get_max_threads();
+    const int64_t chunk_size = (n + nchunks - 1) / nchunks;
+    vector<K> tmp_keys(n);
+    vector<int64_t> tmp_idx(n);
+    vector<int64_t> count(nchunks * 256);
+
+    for (size_t shift = 0; shift < sizeof(K) * 8; shift += 8) {
+        #pragma omp parallel for
+        for (int64_t c = 0; c < nchunks; ++c) {
+            int64_t *cnt = &count[c * 256];
+            fill(cnt, cnt + 256, 0);
+            for (int64_t i = c * chunk_size; i < min(n, (c + 1) * chunk_size); ++i) {
+                ++cnt[(keys[i] >> shift) & 0xFF];
+            }
+        }
+        // The offsets are ordered by digit and then by chunk
+        int64_t offset = 0;
+        bool same_digit = false;
+        for (int64_t d = 0; d < 256; ++d) {
+            const int64_t start = offset;
+            for (int64_t c = 0; c < nchunks; ++c) {
+                const int64_t t = count[c * 256 + d];
+                count[c * 256 + d] = offset;
+                offset += t;
+            }
+            same_digit = same_digit or offset - start == n;
+        }
+        if (same_digit) {
+            continue;
+        }
+        #pragma omp parallel for
+        for (int64_t c = 0; c < nchunks; ++c) {
+            int64_t *cnt = &count[c * 256];
+            for (int64_t i = c * chunk_size; i < min(n, (c + 1) * chunk_size); ++i) {
+                const int64_t pos = cnt[(keys[i] >> shift) & 0xFF]++;
+                tmp_keys[pos] = keys[i];
+                tmp_idx[pos] = idx[i];
+            }
+        }
+        keys.swap(tmp_keys);
+        idx.swap(tmp_idx);
+    }
+}
+
+// The permutation that sorts 'values' stable using a radix sort
+template <typename T>
+vector<int64_t> argsort(const vector<T> &values, bool parallel) {
+    typedef typename RadixKey<T>::type K;
+    const int64_t n = values.size();
+    vector<K> keys(n);
+    vector<int64_t> idx(n);
+    #pragma omp parallel for if(parallel)
+    for (int64_t i = 0; i < n; ++i) {
+        keys[i] = RadixKey<T>::get(values[i]);
+        idx[i] = i;
+    }
+    if (parallel) {
+        parallel_radix_sort(keys, idx);
+    } else {
+        radix_sort(keys, idx);
+    }
+    return idx;
+}
+
+// Three-way comparison of floats where NaNs are ordered last
+template <typename F>
+int compare(F a, F b) {
+    const bool a_nan = std::isnan(a), b_nan = std::isnan(b);
+    if (a_nan or b_nan) {
+        return a_nan - b_nan;
+    }
+    return (a > b) - (a < b);
+}
+
+// Complex numbers are ordered lexicographically by their real and imaginary parts like in NumPy
+template <typename C>
+bool complex_less(const C &a, const C &b) {
+    const int c = compare(a.real, b.real);
+    return c != 0 ? c < 0 : compare(a.imag, b.imag) < 0;
+}
+
+// The permutation that sorts 'values' stable using a merge sort: each thread sorts a chunk, which are then
+// merged pairwise in parallel
+template <typename T>
+vector<int64_t> merge_argsort(const vector<T> &values, bool parallel) {
+    const int64_t n = values.size();
+    vector<int64_t> idx(n);
+    for (int64_t i = 0; i < n; ++i) {
+        idx[i] = i;
+    }
+    auto less = [&](int64_t a, int64_t b) { return complex_less(values[a], values[b]); };
+    if (not parallel) {
+        stable_sort(idx.begin(), idx.end(), less);
+        return idx;
+    }
+    const int64_t nchunks = omp_get_max_threads();
+    int64_t width = (n + nchunks - 1) / nchunks;
+    #pragma omp parallel for
+    for (int64_t c = 0; c < nchunks; ++c) {
+        stable_sort(idx.begin() + min(n, c * width), idx.begin() + min(n, (c + 1) * width), less);
+    }
+    vector<int64_t> tmp(n);
+    for (; width < n; width *= 2) {
+        const int64_t npairs = (n + 2 * width - 1) / (2 * width);
+        #pragma omp parallel for
+        for (int64_t p = 0; p < npairs; ++p) {
+            const int64_t begin = p * 2 * width;
+            const int64_t middle = min(n, begin + width);
+            const int64_t end = min(n, begin + 2 * width);
+            merge(idx.begin() + begin, idx.begin() + middle, idx.begin() + middle, idx.begin() + end,
+                  tmp.begin() + begin, less);
+        }
+        idx.swap(tmp);
+    }
+    return idx;
+}
+
+vector<int64_t> argsort(const vector<bh_complex64> &values, bool parallel) {
+    return merge_argsort(values, parallel);
+}
+
+vector<int64_t> argsort(const vector<bh_complex128> &values, bool parallel) {
+    return merge_argsort(values, parallel);
+}
+
+// The rows of a view along its last axis
+class Rows {
+private:
+    const bh_view &_view;
+public:
+    const int64_t length;
+    const int64_t stride;
+    const int64_t count;
+
+    explicit Rows(const bh_view &view) : _view(view),
+                                         length(view.ndim > 0 ? view.shape[view.ndim - 1] : 1),
+                                         stride(view.ndim > 0 ? view.stride[view.ndim - 1] : 0),
+                                         count(length > 0 ? bh_nelements(view) / length : 0) {}
+
+    // The offset of the first element of 'row'
+    int64_t offset(int64_t row) const {
+        int64_t offset = _view.start;
+        for (int64_t d = _view.ndim - 2; d >= 0; --d) {
+            offset += (row % _view.shape[d]) * _view.stride[d];
+            row /= _view.shape[d];
+        }
+        return offset;
+    }
+};
+
+/* Sort each row of 'in' along the last axis and write the result to 'out', which has the same shape as 'in'.
+ * When 'indices' is true, the sorting permutation is written instead of the sorted values.
+ * Many rows are sorted in parallel whereas the elements of a few long rows are sorted in parallel.
+ */
+template <typename T>
+void sort_rows(const bh_view &out, const bh_view &in, bool indices) {
+    const Rows in_rows(in), out_rows(out);
+    const T *src = static_cast<const T *>(in.base->data);
+    T *dst = static_cast<T *>(out.base->data);
+    int64_t *dst_indices = static_cast<int64_t *>(out.base->data);
+
+    auto sort_row = [&](int64_t row, bool parallel) {
+        vector<T> values(in_rows.length);
+        const int64_t in_offset = in_rows.offset(row);
+        for (int64_t i = 0; i < in_rows.length; ++i) {
+            values[i] = src[in_offset + i * in_rows.stride];
+        }
+        const vector<int64_t> idx = argsort(values, parallel);
+        const int64_t out_offset = out_rows.offset(row);
+        for (int64_t i = 0; i < in_rows.length; ++i) {
+            if (indices) {
+                dst_indices[out_offset + i * out_rows.stride] = idx[i];
+            } else {
+                dst[out_offset + i * out_rows.stride] = values[idx[i]];
+            }
+        }
+    };
+
+    if (in_rows.count >= omp_get_max_threads() or in_rows.length < PARALLEL_ROW_SIZE) {
+        #pragma omp parallel for schedule(dynamic)
+        for (int64_t row = 0; row < in_rows.count; ++row) {
+            sort_row(row, false);
+        }
+    } else {
+        for (int64_t row = 0; row < in_rows.count; ++row) {
+            sort_row(row, true);
+        }
+    }
+}
+
+// Call `sort_rows<T>()` where T is the type of 'in'
+void sort_rows_of_type(const bh_view &out, const bh_view &in, bool indices) {
+    switch (in.base->type) {
+        case bh_type::BOOL:
+            sort_rows<bh_bool>(out, in, indices);
+            break;
+        case bh_type::INT8:
+            sort_rows<bh_int8>(out, in, indices);
+            break;
+        case bh_type::INT16:
+            sort_rows<bh_int16>(out, in, indices);
+            break;
+        case bh_type::INT32:
+            sort_rows<bh_int32>(out, in, indices);
+            break;
+        case bh_type::INT64:
+            sort_rows<bh_int64>(out, in, indices);
+            break;
+        case bh_type::UINT8:
+            sort_rows<bh_uint8>(out, in, indices);
+            break;
+        case bh_type::UINT16:
+            sort_rows<bh_uint16>(out, in, indices);
+            break;
+        case bh_type::UINT32:
+            sort_rows<bh_uint32>(out, in, indices);
+            break;
+        case bh_type::UINT64:
+            sort_rows<bh_uint64>(out, in, indices);
+            break;
+        case bh_type::FLOAT32:
+            sort_rows<bh_float32>(out, in, indices);
+            break;
+        case bh_type::FLOAT64:
+            sort_rows<bh_float64>(out, in, indices);
+            break;
+        case bh_type::COMPLEX64:
+            sort_rows<bh_complex64>(out, in, indices);
+            break;
+        case bh_type::COMPLEX128:
+            sort_rows<bh_complex128>(out, in, indices);
+            break;
+        case bh_type::FLOAT16:
+            sort_rows<bh_float16>(out, in, indices);
+            break;
+        case bh_type::BFLOAT16:
+            sort_rows<bh_bfloat16>(out, in, indices);
+            break;
+        default:
+            throw runtime_error("sort: unsupported data type");
+    }
+}
+
+// Check the operands of a sort, which sorts IN along the last axis into OUT
+void check_operands(const bh_view &out, const bh_view &in) {
+    if (out.ndim != in.ndim or not std::equal(out.shape, out.shape + out.ndim, in.shape)) {
+        throw runtime_error("sort: the input and output must have the same shape");
+    }
+}
+
+// sort: OUT = IN sorted along the last axis. The third operand is ignored.
+class SortImpl : public ExtmethodImpl {
+public:
+    void execute(bh_instruction *instr, void *arg) {
+        const bh_view &out = instr->operand[0];
+        const bh_view &in = instr->operand[1];
+        check_operands(out, in);
+        if (out.base->type != in.base->type) {
+            throw runtime_error("sort: the input and output must have the same type");
+        }
+
+        // Make sure that the arrays memory are allocated.
+        bh_data_malloc(out.base);
+        bh_data_malloc(in.base);
+
+        sort_rows_of_type(out, in, false);
+    }
+};
+
+// argsort: OUT = the indices that sort IN along the last axis. The third operand is ignored.
+class ArgsortImpl : public ExtmethodImpl {
+public:
+    void execute(bh_instruction *instr, void *arg) {
+        const bh_view &out = instr->operand[0];
+        const bh_view &in = instr->operand[1];
+        check_operands(out, in);
+        if (out.base->type != bh_type::INT64) {
+            throw runtime_error("argsort: the output must be of type int64");
+        }
+
+        // Make sure that the arrays memory are allocated.
+        bh_data_malloc(out.base);
+        bh_data_malloc(in.base);
+
+        sort_rows_of_type(out, in, true);
+    }
+};
+} // Unnamed namespace
+
+extern "C" ExtmethodImpl* sort_create() {
+    return new SortImpl();
+}
+extern "C" void sort_destroy(ExtmethodImpl* self) {
+    delete self;
+}
+
+extern "C" ExtmethodImpl* argsort_create() {
+    return new ArgsortImpl();
+}
+extern "C" void argsort_destroy(ExtmethodImpl* self) {
+    delete self;
+}
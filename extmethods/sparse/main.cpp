@@ -0,0 +1,231 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <omp.h>
+
+#include <bh_extmethod.hpp>
+
+#include "../arith.hpp"
+
+using namespace bohrium;
+using namespace extmethod;
+using namespace std;
+
+namespace {
+
+// The elements of a 1-D view
+template <typename T>
+class Vector {
+private:
+    T *_data;
+    const int64_t _stride;
+public:
+    explicit Vector(const bh_view &view) : _data(static_cast<T *>(view.base->data) + view.start),
+                                           _stride(view.stride[0]) {}
+    T &operator[](int64_t i) const { return _data[i * _stride]; }
+};
+
+/* Y = A @ X where A is a CSR matrix. The nonzeros are split evenly between the threads (as opposed to the
+ * rows) such that a few long rows, like in power-law graphs, doesn't leave the other threads idle:
+ *   - Each thread computes the rows that start in its range of nonzeros.
+ *   - A row that continues into the range of the following threads is finished after a barrier by adding
+ *     the partial sums of the following threads in order.
+ */
+template <typename T, typename ARITH>
+void spmv_csr(const bh_view &out, const bh_view &indptr_view, const bh_view &indices_view,
+              const bh_view &data_view, const bh_view &x_view) {
+    typedef typename ARITH::acc Acc;
+    const Vector<T> y(out);
+    const Vector<const bh_int64> indptr(indptr_view);
+    const Vector<const bh_int64> indices(indices_view);
+    const Vector<const T> data(data_view);
+    const Vector<const T> x(x_view);
+    const int64_t nrows = out.shape[0];
+    const int64_t first = indptr[0];
+    const int64_t nnz = indptr[nrows] - first;
+
+    // The row and partial sum that each thread starts in the middle of (head) and leaves unfinished (tail)
+    const int64_t max_threads = omp_get_max_threads();
+    vector<int64_t> head_row(max_threads, -1), tail_row(max_threads, -1);
+    vector<Acc> head_sum(max_threads, ARITH::zero()), tail_sum(max_threads, ARITH::zero());
+
+    // The dot product of row elements [begin, end) and `x`
+    auto dot = [&](int64_t begin, int64_t end) {
+        Acc sum = ARITH::zero();
+        for (int64_t k = begin; k < end; ++k) {
+            ARITH::madd(sum, ARITH::load(data[k]), ARITH::load(x[indices[k]]));
+        }
+        return sum;
+    };
+
+    #pragma omp parallel
+    {
+        const int64_t tid = omp_get_thread_num();
+        const int64_t nthds = omp_get_num_threads();
+        const bool last = tid == nthds - 1;
+        const int64_t k_begin = first + nnz * tid / nthds;
+        const int64_t k_end = first + nnz * (tid + 1) / nthds;
+
+        // The first row that starts in our range of nonzeros
+        int64_t lo = 0, hi = nrows;
+        while (lo < hi) {
+            const int64_t mid = (lo + hi) / 2;
+            if (indptr[mid] < k_begin) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        int64_t row = lo;
+
+        // The end of the row that started before our range
+        const int64_t head_end = std::min(row < nrows ? indptr[row] : indptr[nrows], k_end);
+        if (k_begin < head_end) {
+            head_row[tid] = row - 1;
+            head_sum[tid] = dot(k_begin, head_end);
+        }
+
+        // The rows that start in our range, the last thread also takes the trailing empty rows
+        for (; row < nrows and (indptr[row] < k_end or last); ++row) {
+            const int64_t row_end = indptr[row + 1];
+            if (row_end <= k_end) {
+                y[row] = ARITH::store(dot(indptr[row], row_end));
+            } else {
+                tail_row[tid] = row;
+                tail_sum[tid] = dot(indptr[row], k_end);
+            }
+        }
+
+        #pragma omp barrier
+        if (tail_row[tid] >= 0) {
+            Acc sum = tail_sum[tid];
+            for (int64_t t = tid + 1; t < nthds; ++t) {
+                if (head_row[t] == tail_row[tid]) {
+                    ARITH::add(sum, head_sum[t]);
+                } else if (nnz * (t + 1) / nthds != nnz * t / nthds) {
+                    break; // A non-empty range of nonzeros that doesn't continue the row
+                }
+            }
+            y[tail_row[tid]] = ARITH::store(sum);
+        }
+    }
+}
+
+template <typename T, typename ARITH>
+struct SpmvCsr {
+    static void run(const bh_view &out, const bh_view &indptr, const bh_view &indices, const bh_view &data,
+                    const bh_view &x) {
+        spmv_csr<T, ARITH>(out, indptr, indices, data, x);
+    }
+};
+
+// Throws unless the row pointers are non-decreasing and within `data`, and the column indices of the
+// nonzeros are within `x`, since spmv_csr() reads the elements without bound checks.
+void check_csr(const bh_view &out, const bh_view &indptr_view, const bh_view &indices_view,
+               const bh_view &data_view, const bh_view &x_view) {
+    const Vector<const bh_int64> indptr(indptr_view);
+    const Vector<const bh_int64> indices(indices_view);
+    const int64_t nrows = out.shape[0];
+    const int64_t ncols = x_view.shape[0];
+    const int64_t first = indptr[0];
+    const int64_t last = indptr[nrows];
+    if (first < 0 or last > data_view.shape[0]) {
+        throw runtime_error("spmv_csr: indptr refers to the nonzeros [" + to_string(first) + ", " +
+                            to_string(last) + ") but data contains " + to_string(data_view.shape[0]));
+    }
+
+    int64_t decreasing = 0;
+    #pragma omp parallel for reduction(+:decreasing)
+    for (int64_t i = 0; i < nrows; ++i) {
+        decreasing += indptr[i + 1] < indptr[i];
+    }
+    if (decreasing > 0) {
+        throw runtime_error("spmv_csr: indptr must be non-decreasing but decreases " + to_string(decreasing) +
+                            " times");
+    }
+
+    int64_t out_of_bounds = 0;
+    #pragma omp parallel for reduction(+:out_of_bounds)
+    for (int64_t k = first; k < last; ++k) {
+        out_of_bounds += indices[k] < 0 or indices[k] >= ncols;
+    }
+    if (out_of_bounds > 0) {
+        throw runtime_error("spmv_csr: " + to_string(out_of_bounds) + " column indices are outside of x, "
+                            "which has " + to_string(ncols) + " elements");
+    }
+}
+
+// spmv_csr: OUT = A @ IN4 where A is a sparse matrix in the CSR format: the row pointers IN1,
+// the column indices IN2 and the nonzero values IN3.
+class SpmvCsrImpl : public ExtmethodImpl {
+public:
+    void execute(bh_instruction *instr, void *arg) {
+        if (instr->operand.size() != 5) {
+            throw runtime_error("spmv_csr: expects five operands (y, indptr, indices, data, x)");
+        }
+        const bh_view &out = instr->operand[0];
+        const bh_view &indptr = instr->operand[1];
+        const bh_view &indices = instr->operand[2];
+        const bh_view &data = instr->operand[3];
+        const bh_view &x = instr->operand[4];
+
+        for (const bh_view &view: instr->operand) {
+            if (view.ndim != 1) {
+                throw runtime_error("spmv_csr: all operands must be vectors");
+            }
+        }
+        if (out.base->type != data.base->type or out.base->type != x.base->type) {
+            throw runtime_error("spmv_csr: the data, x, and output must have the same type");
+        }
+        if (indptr.base->type != bh_type::INT64 or indices.base->type != bh_type::INT64) {
+            throw runtime_error("spmv_csr: indptr and indices must be of type int64");
+        }
+        if (indptr.shape[0] != out.shape[0] + 1 or indices.shape[0] != data.shape[0]) {
+            stringstream ss;
+            ss << "spmv_csr: the shapes of the operands doesn't match, y " << out << ", indptr " << indptr
+               << ", indices " << indices << ", and data " << data;
+            throw runtime_error(ss.str());
+        }
+
+        // Make sure that the arrays memory are allocated.
+        for (const bh_view &view: instr->operand) {
+            bh_data_malloc(view.base);
+        }
+
+        // The Python bridge computes booleans without the extension method
+        if (out.base->type == bh_type::BOOL) {
+            throw runtime_error("spmv_csr: unsupported type " + string(bh_type_text(out.base->type)));
+        }
+        check_csr(out, indptr, indices, data, x);
+        dispatch_arith<SpmvCsr>("spmv_csr", out.base->type, out, indptr, indices, data, x);
+    }
+};
+} // Unnamed namespace
+
+extern "C" ExtmethodImpl* spmv_csr_create() {
+    return new SpmvCsrImpl();
+}
+extern "C" void spmv_csr_destroy(ExtmethodImpl* self) {
+    delete self;
+}
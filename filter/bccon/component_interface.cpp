@@ -20,15 +20,29 @@ If not, see <http://www.gnu.org/licenses/>.
 
 #include <bh_component.hpp>
 #include "contracter.hpp"
+#include "repeat_finder.hpp"
 
 using namespace bohrium;
 using namespace component;
 using namespace std;
 
 namespace {
+
+// Returns the rules of the algebraic simplification that are enabled in 'config'
+set<string> algebra_rules(const ConfigParser &config) {
+    set<string> ret;
+    for (const auto &rule: filter::bccon::Contracter::algebra_rule_defaults()) {
+        if (config.defaultGet<bool>("algebra_" + rule.first, rule.second)) {
+            ret.insert(rule.first);
+        }
+    }
+    return ret;
+}
+
 class Impl : public ComponentImplWithChild {
 private:
     filter::bccon::Contracter contractor;
+    filter::bccon::RepeatFinder repeat_finder;
 public:
     Impl(int stack_level) : ComponentImplWithChild(stack_level),
                             contractor(config.defaultGet<bool>("verbose", false),
@@ -36,13 +50,48 @@ public:
                                        config.defaultGet<bool>("reduction", false),
                                        config.defaultGet<bool>("stupidmath", false),
                                        config.defaultGet<bool>("collect", false),
-                                       config.defaultGet<bool>("muladd", false)) {};
+                                       config.defaultGet<bool>("muladd", false),
+                                       config.defaultGet<bool>("copy_elimination", false),
+                                       config.defaultGet<bool>("cse", false),
+                                       config.defaultGet<bool>("dead_computation", false),
+                                       config.defaultGet<bool>("algebra", false),
+                                       algebra_rules(config)) {};
 
-    ~Impl() {}; // NB: a destructor implementation must exist
+    ~Impl() {
+        repeat_finder.flush(child);
+    };
     void execute(BhIR *bhir) {
         contractor.contract(*bhir);
-        child.execute(bhir);
+        if (contractor.repeats()) {
+            repeat_finder.execute(*bhir, child);
+        } else {
+            child.execute(bhir);
+        }
+        // NB: the repeat finder has replaced the temporary arrays of a deferred BhIR
+        contractor.gc();
+    };
+    // NB: the deferred BhIR must execute before anything else reaches the child
+    void extmethod(const std::string &name, bh_opcode opcode) {
+        repeat_finder.flush(child);
+        child.extmethod(name, opcode);
+    };
+    std::string message(const std::string &msg) {
+        repeat_finder.flush(child);
+        if (msg == "statistic_enable_and_reset") {
+            contractor.resetStatistic();
+        } else if (msg == "statistic") {
+            return contractor.statistic() + child.message(msg);
+        }
+        return child.message(msg);
+    }
+    void* getMemoryPointer(bh_base &base, bool copy2host, bool force_alloc, bool nullify) {
+        repeat_finder.flush(child);
+        return child.getMemoryPointer(base, copy2host, force_alloc, nullify);
     };
+    void setMemoryPointer(bh_base *base, bool host_ptr, void *mem) {
+        repeat_finder.flush(child);
+        return child.setMemoryPointer(base, host_ptr, mem);
+    }
 };
 } //Unnamed namespace
 
@@ -0,0 +1,371 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <cmath>
+#include <map>
+#include <stdexcept>
+
+#include <bh_util.hpp>
+
+#include "contracter.hpp"
+
+using namespace std;
+
+namespace bohrium {
+namespace filter {
+namespace bccon {
+
+namespace {
+
+// The largest exponent that the 'powk' rule unfolds into multiplications (as in the bcexp filter)
+constexpr int64_t max_exponent_unfolding = 100;
+
+// A rewrite rule gets the instruction at 'pc' and appends its replacement to 'rewritten' when it matches
+typedef bool (*RewriteFunc)(const BhIR &bhir, size_t pc, vector<bh_instruction> &rewritten, Contracter &contracter);
+
+struct RewriteRule {
+    // The name of the rule, which is toggled by the config option "algebra_<name>"
+    const char *name;
+    RewriteFunc rewrite;
+    // Is the rule enabled when the config doesn't mention it? Only rules that never change the result are.
+    bool enabled_by_default;
+};
+
+// Is 'type' a real floating point type?
+inline bool is_real_float(bh_type type) {
+    return type == bh_type::FLOAT32 or type == bh_type::FLOAT64;
+}
+
+// Returns true and the value of the constant operand 'idx' of 'instr' in 'value' when it is a real number
+bool constant_value(const bh_instruction &instr, size_t idx, double &value) {
+    if (instr.operand.size() <= idx or not bh_is_constant(&instr.operand[idx])) {
+        return false;
+    }
+    try {
+        value = instr.constant.get_double();
+    } catch (overflow_error &e) {
+        return false;
+    }
+    return true;
+}
+
+// Is the operand 'idx' of 'instr' the constant 'value'?
+inline bool is_constant(const bh_instruction &instr, size_t idx, double value) {
+    double v;
+    return constant_value(instr, idx, v) and v == value;
+}
+
+// Is the operand 'idx' of 'instr' a zero that keeps every value when it is added (or subtracted when 'negated')?
+// NB: on floats, only adding -0.0 and subtracting 0.0 keep -0.0 since -0.0 + 0.0 is 0.0
+inline bool is_additive_identity(const bh_instruction &instr, size_t idx, bool negated=false) {
+    double v;
+    if (not constant_value(instr, idx, v) or v != 0) {
+        return false;
+    }
+    return not bh_type_is_float(instr.operand[0].base->type) or std::signbit(v) != negated;
+}
+
+// Returns the instruction: 'opcode' 'out' 'in'
+bh_instruction unary(bh_opcode opcode, const bh_view &out, const bh_view &in) {
+    return bh_instruction(opcode, {out, in});
+}
+
+// Returns the instruction: 'opcode' 'out' 'in1' 'in2'
+bh_instruction binary(bh_opcode opcode, const bh_view &out, const bh_view &in1, const bh_view &in2) {
+    return bh_instruction(opcode, {out, in1, in2});
+}
+
+// Returns the instruction: BH_IDENTITY 'out' 'value' where the constant has the type of 'out'
+bh_instruction fill(const bh_view &out, double value) {
+    bh_instruction instr(BH_IDENTITY, {out});
+    instr.operand.resize(2);
+    bh_flag_constant(&instr.operand[1]);
+    instr.constant.type = out.base->type;
+    instr.constant.set_double(value);
+    return instr;
+}
+
+// x*1, 1*x, x/1, x+0, 0+x, x-0, x**1  =>  x
+// NB: on floats, the zero must be -0.0 when added and 0.0 when subtracted to keep -0.0
+bool rewrite_identity(const BhIR &bhir, size_t pc, vector<bh_instruction> &rewritten, Contracter &contracter) {
+    const bh_instruction &instr = bhir.instr_list[pc];
+    size_t keep;
+    switch (instr.opcode) {
+        case BH_MULTIPLY:
+            if (is_constant(instr, 2, 1)) {
+                keep = 1;
+            } else if (is_constant(instr, 1, 1)) {
+                keep = 2;
+            } else {
+                return false;
+            }
+            break;
+        case BH_ADD:
+            if (is_additive_identity(instr, 2)) {
+                keep = 1;
+            } else if (is_additive_identity(instr, 1)) {
+                keep = 2;
+            } else {
+                return false;
+            }
+            break;
+        case BH_DIVIDE:
+        case BH_POWER:
+            if (not is_constant(instr, 2, 1)) {
+                return false;
+            }
+            keep = 1;
+            break;
+        case BH_SUBTRACT:
+            if (not is_additive_identity(instr, 2, true)) {
+                return false;
+            }
+            keep = 1;
+            break;
+        default:
+            return false;
+    }
+    if (instr.operand[keep].base->type != instr.operand[0].base->type) {
+        return false;
+    }
+    rewritten.push_back(unary(BH_IDENTITY, instr.operand[0], instr.operand[keep]));
+    return true;
+}
+
+// x-x, x^x  =>  0 on integers (on floats, inf-inf is nan)
+bool rewrite_self_cancel(const BhIR &bhir, size_t pc, vector<bh_instruction> &rewritten, Contracter &contracter) {
+    const bh_instruction &instr = bhir.instr_list[pc];
+    if (instr.opcode != BH_SUBTRACT and instr.opcode != BH_BITWISE_XOR and instr.opcode != BH_LOGICAL_XOR) {
+        return false;
+    }
+    if (bh_is_constant(&instr.operand[1]) or bh_is_constant(&instr.operand[2]) or
+        instr.operand[1] != instr.operand[2] or bh_type_is_float(instr.operand[1].base->type)) {
+        return false;
+    }
+    rewritten.push_back(fill(instr.operand[0], 0));
+    return true;
+}
+
+// x**0.5  =>  sqrt(x)
+// NB: differs from pow() at -0.0 and -inf, where sqrt() returns -0.0 and nan
+bool rewrite_pow_sqrt(const BhIR &bhir, size_t pc, vector<bh_instruction> &rewritten, Contracter &contracter) {
+    const bh_instruction &instr = bhir.instr_list[pc];
+    if (instr.opcode != BH_POWER or not is_real_float(instr.operand[0].base->type) or
+        not is_constant(instr, 2, 0.5)) {
+        return false;
+    }
+    rewritten.push_back(unary(BH_SQRT, instr.operand[0], instr.operand[1]));
+    return true;
+}
+
+// x**-1  =>  1/x
+bool rewrite_pow_reciprocal(const BhIR &bhir, size_t pc, vector<bh_instruction> &rewritten, Contracter &contracter) {
+    const bh_instruction &instr = bhir.instr_list[pc];
+    if (instr.opcode != BH_POWER or not is_real_float(instr.operand[0].base->type) or
+        not is_constant(instr, 2, -1)) {
+        return false;
+    }
+    bh_instruction reciprocal(BH_DIVIDE, {instr.operand[0]});
+    reciprocal.operand.resize(3);
+    bh_flag_constant(&reciprocal.operand[1]);
+    reciprocal.operand[2] = instr.operand[1];
+    reciprocal.constant = instr.constant;
+    reciprocal.constant.set_double(1);
+    rewritten.push_back(reciprocal);
+    return true;
+}
+
+// x/c  =>  x*(1/c)
+bool rewrite_div_const(const BhIR &bhir, size_t pc, vector<bh_instruction> &rewritten, Contracter &contracter) {
+    const bh_instruction &instr = bhir.instr_list[pc];
+    double divisor;
+    if (instr.opcode != BH_DIVIDE or not is_real_float(instr.operand[0].base->type) or
+        not constant_value(instr, 2, divisor) or divisor == 0 or not std::isfinite(divisor)) {
+        return false;
+    }
+    bh_instruction multiply(instr);
+    multiply.opcode = BH_MULTIPLY;
+    multiply.constant.set_double(1.0 / divisor);
+    rewritten.push_back(multiply);
+    return true;
+}
+
+// log(exp(x))  =>  x
+// NB: differs when exp(x) overflows to inf or underflows to 0
+bool rewrite_log_exp(const BhIR &bhir, size_t pc, vector<bh_instruction> &rewritten, Contracter &contracter) {
+    const bh_instruction &instr = bhir.instr_list[pc];
+    if (instr.opcode != BH_LOG or bh_is_constant(&instr.operand[1]) or
+        not is_real_float(instr.operand[0].base->type)) {
+        return false;
+    }
+    const bh_view &exp_out = instr.operand[1];
+
+    // Let's find the instruction that wrote the input of the log
+    for (size_t i = pc; i-- > 0; ) {
+        const bh_instruction &prev = bhir.instr_list[i];
+        if (prev.opcode == BH_NONE or prev.operand.empty() or prev.operand[0].base != exp_out.base) {
+            continue;
+        }
+        if (prev.opcode != BH_EXP or prev.operand[0] != exp_out or bh_is_constant(&prev.operand[1])) {
+            return false;
+        }
+        const bh_view &x = prev.operand[1];
+        if (x.base == exp_out.base) {
+            return false;
+        }
+        // 'x' must not change between the exp and the log
+        for (size_t j = i + 1; j < pc; ++j) {
+            const bh_instruction &between = bhir.instr_list[j];
+            if (between.opcode != BH_NONE and not between.operand.empty() and between.operand[0].base == x.base) {
+                return false;
+            }
+        }
+        rewritten.push_back(unary(BH_IDENTITY, instr.operand[0], x));
+        return true;
+    }
+    return false;
+}
+
+// x**k  =>  x*x*...*x using binary exponentiation, which needs a temporary array when the output aliases 'x'.
+// NB: only integers multiply exactly, floats might differ from pow() in the last bit
+bool rewrite_powk(const BhIR &bhir, size_t pc, vector<bh_instruction> &rewritten, Contracter &contracter) {
+    const bh_instruction &instr = bhir.instr_list[pc];
+    double exponent;
+    if (instr.opcode != BH_POWER or bh_is_constant(&instr.operand[1]) or
+        not bh_type_is_integer(instr.operand[0].base->type) or not constant_value(instr, 2, exponent) or
+        exponent < 0 or exponent > max_exponent_unfolding or exponent != std::floor(exponent)) {
+        return false;
+    }
+    const bh_view &out = instr.operand[0];
+    const bh_view &x = instr.operand[1];
+    const int64_t k = static_cast<int64_t>(exponent);
+    if (k == 0) {
+        rewritten.push_back(fill(out, 1));
+        return true;
+    } else if (k == 1) {
+        rewritten.push_back(unary(BH_IDENTITY, out, x));
+        return true;
+    }
+
+    // Left-to-right binary exponentiation: the leading bit of 'k' is 'x' itself
+    int leading_bit = 62;
+    while (((k >> leading_bit) & 1) == 0) {
+        --leading_bit;
+    }
+    int nsteps = leading_bit;
+    for (int bit = leading_bit - 1; bit >= 0; --bit) {
+        nsteps += (k >> bit) & 1;
+    }
+
+    // When the output aliases 'x', we accumulate in a temporary array except for the last step,
+    // which may write the output directly when it reads 'x' element-wise
+    const bool use_temp = out.base == x.base and (nsteps > 1 or out != x);
+    const bh_view acc = use_temp ? contracter.createTemp(out) : out;
+    vector<bh_instruction> steps;
+    for (int bit = leading_bit - 1; bit >= 0; --bit) {
+        if (steps.empty()) {
+            steps.push_back(binary(BH_MULTIPLY, acc, x, x));
+        } else {
+            steps.push_back(binary(BH_MULTIPLY, acc, acc, acc));
+        }
+        if ((k >> bit) & 1) {
+            steps.push_back(binary(BH_MULTIPLY, acc, acc, x));
+        }
+    }
+    if (use_temp) {
+        if (out == x) {
+            steps.back().operand[0] = out;
+        } else {
+            steps.push_back(unary(BH_IDENTITY, out, acc));
+        }
+        steps.push_back(bh_instruction(BH_FREE, {acc}));
+    }
+    rewritten.insert(rewritten.end(), steps.begin(), steps.end());
+    return true;
+}
+
+// The rewrite rules in the order they are tried
+const RewriteRule rules[] = {
+    {"identity",       rewrite_identity,       true},
+    {"self_cancel",    rewrite_self_cancel,    true},
+    {"pow_sqrt",       rewrite_pow_sqrt,       false},
+    {"pow_reciprocal", rewrite_pow_reciprocal, true},
+    {"div_const",      rewrite_div_const,      false},
+    {"log_exp",        rewrite_log_exp,        false},
+    {"powk",           rewrite_powk,           true},
+};
+
+} // Anonymous Namespace
+
+map<string, bool> Contracter::algebra_rule_defaults()
+{
+    map<string, bool> ret;
+    for (const RewriteRule &rule: rules) {
+        ret[rule.name] = rule.enabled_by_default;
+    }
+    return ret;
+}
+
+/*
+We are looking for algebraic expressions that can be computed more cheaply such as:
+
+  BH_POWER a1 a0 0.5
+  BH_DIVIDE a2 a1 4.0
+
+which can be rewritten as:
+
+  BH_SQRT a1 a0
+  BH_MULTIPLY a2 a1 0.25
+
+Each rule in `rules` is enabled by the config option "algebra_<name>". The first matching rule
+rewrites the instruction.
+*/
+
+void Contracter::algebra(BhIR &bhir)
+{
+    vector<bh_instruction> rewritten;
+    rewritten.reserve(bhir.instr_list.size());
+    bool changed = false;
+
+    for (size_t pc = 0; pc < bhir.instr_list.size(); ++pc) {
+        const bh_instruction &instr = bhir.instr_list[pc];
+        bool matched = false;
+        if (not bh_opcode_is_system(instr.opcode) and instr.opcode <= BH_MAX_OPCODE_ID) {
+            for (const RewriteRule &rule: rules) {
+                if (util::exist(algebra_rules_, rule.name) and rule.rewrite(bhir, pc, rewritten, *this)) {
+                    verbose_print("[Algebra] Rewriting " + std::string(bh_opcode_text(instr.opcode)) +
+                                  " using rule '" + rule.name + "'");
+                    ++num_algebra_;
+                    matched = true;
+                    break;
+                }
+            }
+        }
+        if (matched) {
+            changed = true;
+        } else {
+            rewritten.push_back(instr);
+        }
+    }
+    if (changed) {
+        bhir.instr_list = std::move(rewritten);
+    }
+}
+
+}}}
@@ -0,0 +1,122 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <bh_util.hpp>
+
+#include "contracter.hpp"
+
+using namespace std;
+
+namespace bohrium {
+namespace filter {
+namespace bccon {
+
+// Is 'instr' a copy of an array view into a view of another array of the same type?
+static inline bool is_pure_copy(const bh_instruction& instr)
+{
+    return instr.opcode == BH_IDENTITY and
+           not bh_is_constant(&instr.operand[1]) and
+           instr.operand[0].base != instr.operand[1].base and
+           instr.operand[0].base->type == instr.operand[1].base->type;
+}
+
+// Forwards the reads of the copy at 'pc' to the source of the copy and returns true when all reads
+// of the destination were forwarded before the destination is freed
+static bool forward_copy(BhIR &bhir, size_t pc)
+{
+    vector<bh_instruction> &instr_list = bhir.instr_list;
+    const bh_view dst = instr_list[pc].operand[0];
+    const bh_view src = instr_list[pc].operand[1];
+
+    bool all_forwarded = true;
+    for (size_t i = pc+1; i < instr_list.size(); ++i) {
+        bh_instruction& instr = instr_list[i];
+        if (instr.opcode == BH_NONE) {
+            continue;
+        }
+        if (instr.opcode == BH_FREE) {
+            if (instr.operand[0].base == dst.base) {
+                return all_forwarded;
+            } else if (instr.operand[0].base == src.base) {
+                return false;
+            }
+            continue;
+        }
+        // The reads of 'dst' can use 'src' unless the instruction also writes to the source array
+        const bool forwardable = not bh_opcode_is_system(instr.opcode) and instr.opcode <= BH_MAX_OPCODE_ID and
+                                 instr.operand[0].base != src.base;
+        for (size_t o = bh_opcode_is_system(instr.opcode) ? 0 : 1; o < instr.operand.size(); ++o) {
+            bh_view &view = instr.operand[o];
+            if (not bh_is_constant(&view) and view.base == dst.base) {
+                if (forwardable and view == dst) {
+                    view = src;
+                } else {
+                    all_forwarded = false;
+                }
+            }
+        }
+        // Writing to either array ends the forwarding. NB: an extension method might write to any of its operands.
+        if (not bh_opcode_is_system(instr.opcode) and
+            (instr.operand[0].base == dst.base or instr.operand[0].base == src.base)) {
+            return false;
+        }
+        if (instr.opcode > BH_MAX_OPCODE_ID) {
+            for (const bh_view &view: instr.operand) {
+                if (not bh_is_constant(&view) and (view.base == dst.base or view.base == src.base)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+/*
+We are looking for copies such as:
+
+  BH_IDENTITY a1 a0
+  BH_IDENTITY a2 a1
+  BH_ADD a3 a2 a2
+  BH_FREE a1
+  BH_FREE a2
+
+which can be rewritten as:
+
+  BH_ADD a3 a0 a0
+
+When the reads of a copy are forwarded to its source, a copy into a temporary array is removed.
+*/
+
+void Contracter::copy(BhIR &bhir)
+{
+    for(size_t pc = 0; pc < bhir.instr_list.size(); ++pc) {
+        bh_instruction& instr = bhir.instr_list[pc];
+        if (not is_pure_copy(instr)) {
+            continue;
+        }
+        bh_base *dst = instr.operand[0].base;
+        if (forward_copy(bhir, pc) and not util::exist(bhir._syncs, dst) and dst != bhir.getRepeatCondition()) {
+            verbose_print("[Copy] Removing copy into a temporary array");
+            ++num_copy_;
+            instr.opcode = BH_NONE;
+        }
+    }
+}
+
+}}}
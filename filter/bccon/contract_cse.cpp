@@ -0,0 +1,205 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <bh_util.hpp>
+
+#include "contracter.hpp"
+
+using namespace std;
+
+namespace bohrium {
+namespace filter {
+namespace bccon {
+
+// Is 'instr' a pure computation of its inputs, which we can reuse?
+static inline bool is_pure(const bh_instruction& instr)
+{
+    if (bh_opcode_is_system(instr.opcode) or instr.opcode > BH_MAX_OPCODE_ID or instr.operand.empty() or
+        instr.opcode == BH_SCATTER or instr.opcode == BH_COND_SCATTER) {
+        return false;
+    }
+    // The output must not be one of the inputs
+    for (size_t i = 1; i < instr.operand.size(); ++i) {
+        if (not bh_is_constant(&instr.operand[i]) and instr.operand[i].base == instr.operand[0].base) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Does 'a' and 'b' compute the same values?
+static bool same_computation(const bh_instruction& a, const bh_instruction& b)
+{
+    if (a.opcode != b.opcode or a.operand.size() != b.operand.size() or
+        a.operand[0].base->type != b.operand[0].base->type or a.operand[0].ndim != b.operand[0].ndim) {
+        return false;
+    }
+    for (int64_t i = 0; i < a.operand[0].ndim; ++i) {
+        if (a.operand[0].shape[i] != b.operand[0].shape[i]) {
+            return false;
+        }
+    }
+    for (size_t i = 1; i < a.operand.size(); ++i) {
+        if (bh_is_constant(&a.operand[i]) xor bh_is_constant(&b.operand[i])) {
+            return false;
+        } else if (bh_is_constant(&a.operand[i])) {
+            if (a.constant != b.constant) {
+                return false;
+            }
+        } else if (a.operand[i] != b.operand[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Does 'instr' access 'base'?
+static inline bool accesses(const bh_instruction& instr, const bh_base *base)
+{
+    for (const bh_view &view: instr.operand) {
+        if (not bh_is_constant(&view) and view.base == base) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Tries to replace all uses of the base of 'dead', which the instruction at 'pc' writes, with the base of 'live'
+// that has the same values. This is possible when 'dead' is a temporary that is freed within 'instr_list',
+// and neither of the base arrays is written after 'pc'.
+static bool substitute_base(BhIR &bhir, size_t pc, const bh_view &dead, const bh_view &live)
+{
+    vector<bh_instruction> &instr_list = bhir.instr_list;
+    bh_base *dead_base = dead.base;
+    bh_base *live_base = live.base;
+    if (not (is_whole_base(dead) and is_whole_base(live)) or util::exist(bhir._syncs, dead_base)) {
+        return false;
+    }
+
+    // Let's find the free of 'dead_base' and the free of 'live_base'
+    size_t dead_free = instr_list.size();
+    size_t live_free = instr_list.size();
+    for (size_t i = pc+1; i < instr_list.size() and dead_free == instr_list.size(); ++i) {
+        const bh_instruction &instr = instr_list[i];
+        if (instr.opcode == BH_FREE) {
+            if (instr.operand[0].base == dead_base) {
+                dead_free = i;
+            } else if (instr.operand[0].base == live_base) {
+                live_free = i;
+            }
+        } else if (instr.opcode != BH_NONE and not instr.operand.empty() and
+                   (instr.operand[0].base == dead_base or instr.operand[0].base == live_base)) {
+            return false;
+        }
+    }
+    if (dead_free == instr_list.size()) {
+        return false;
+    }
+
+    // Replace the uses of 'dead_base'. If 'live_base' is freed before the last use, we move the free.
+    for (size_t i = pc+1; i < dead_free; ++i) {
+        for (bh_view &view: instr_list[i].operand) {
+            if (not bh_is_constant(&view) and view.base == dead_base) {
+                view.base = live_base;
+            }
+        }
+    }
+    if (live_free < dead_free) {
+        instr_list[live_free].opcode = BH_NONE;
+        instr_list[dead_free].operand[0].base = live_base;
+    } else {
+        instr_list[dead_free].opcode = BH_NONE;
+    }
+    instr_list[pc].opcode = BH_NONE;
+    return true;
+}
+
+/*
+We are looking for instructions that compute the same values on the same views such as:
+
+  BH_MULTIPLY a1 a0 a0
+  BH_MULTIPLY a2 a0 a0
+  BH_ADD a3 a1 a2
+  BH_FREE a1
+  BH_FREE a2
+
+which can be rewritten as:
+
+  BH_MULTIPLY a1 a0 a0
+  BH_ADD a3 a1 a1
+  BH_FREE a1
+
+When the redundant result isn't a temporary, the redundant instruction becomes a BH_IDENTITY of the earlier result.
+*/
+
+void Contracter::cse(BhIR &bhir)
+{
+    vector<bh_instruction> &instr_list = bhir.instr_list;
+
+    // The indexes of the instructions whose results are still available
+    vector<size_t> available;
+
+    for(size_t pc = 0; pc < instr_list.size(); ++pc) {
+        bh_instruction& instr = instr_list[pc];
+        if (instr.opcode == BH_NONE or instr.operand.empty()) {
+            continue;
+        }
+        const bh_base *written = instr.operand[0].base;
+
+        if (is_pure(instr)) {
+            for (size_t i: available) {
+                const bh_instruction &earlier = instr_list[i];
+                if (same_computation(earlier, instr)) {
+                    verbose_print("[CSE] Reusing the result of " + std::string(bh_opcode_text(instr.opcode)));
+                    ++num_cse_;
+                    if (instr.operand[0] == earlier.operand[0]) {
+                        instr.opcode = BH_NONE;
+                    } else if (not substitute_base(bhir, pc, instr.operand[0], earlier.operand[0])) {
+                        instr.opcode = BH_IDENTITY;
+                        instr.operand.resize(2);
+                        instr.operand[1] = earlier.operand[0];
+                    }
+                    break;
+                }
+            }
+        }
+
+        // The results that depend on the written (or freed) base array are no longer available.
+        // NB: an extension method might write to any of its operands.
+        vector<size_t> still_available;
+        for (size_t i: available) {
+            bool invalidated = accesses(instr_list[i], written);
+            if (instr.opcode > BH_MAX_OPCODE_ID) {
+                for (const bh_view &view: instr.operand) {
+                    invalidated = invalidated or (not bh_is_constant(&view) and accesses(instr_list[i], view.base));
+                }
+            }
+            if (not invalidated) {
+                still_available.push_back(i);
+            }
+        }
+        available = std::move(still_available);
+
+        if (instr.opcode != BH_NONE and is_pure(instr)) {
+            available.push_back(pc);
+        }
+    }
+}
+
+}}}
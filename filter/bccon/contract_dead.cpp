@@ -0,0 +1,124 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <map>
+
+#include <bh_util.hpp>
+
+#include "contracter.hpp"
+
+using namespace std;
+
+namespace bohrium {
+namespace filter {
+namespace bccon {
+
+// The liveness of a base array at a point in the instruction list
+struct Liveness {
+    // Is the base array read after this point (or is it still allocated at the end of the list)?
+    bool live = true;
+    // The views that are overwritten after this point before any read of the base array
+    vector<bh_view> shadows;
+};
+
+// Does a later write to one of the 'shadows' overwrite all of 'view'?
+static inline bool is_shadowed(const bh_view& view, const vector<bh_view>& shadows)
+{
+    for (const bh_view &shadow: shadows) {
+        if (shadow == view or is_whole_base(shadow)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+We are looking for instructions whose results are never read such as:
+
+  BH_ADD a1 a0 a0
+  BH_FREE a1
+
+or
+
+  BH_ADD a1[0:10] a0 a0
+  BH_IDENTITY a1[0:10] 0
+  BH_SYNC a1
+
+Both BH_ADD instructions can be removed. We walk the instruction list backwards, thus removing an instruction
+might make the instructions that compute its inputs dead as well.
+*/
+
+void Contracter::dead(BhIR &bhir)
+{
+    map<const bh_base*, Liveness> bases;
+    uint64_t num_removed = 0;
+    uint64_t work = 0;
+
+    for (size_t i = bhir.instr_list.size(); i-- > 0; ) {
+        bh_instruction& instr = bhir.instr_list[i];
+        if (instr.opcode == BH_NONE or instr.operand.empty()) {
+            continue;
+        }
+        bh_base *out = instr.operand[0].base;
+
+        // The synced arrays and the repeat condition are always live
+        const bool external = util::exist(bhir._syncs, out) or out == bhir.getRepeatCondition();
+
+        if (instr.opcode == BH_FREE) {
+            if (not external) {
+                bases[out].live = false;
+                bases[out].shadows.clear();
+            }
+            continue;
+        }
+
+        if (not bh_opcode_is_system(instr.opcode) and instr.opcode <= BH_MAX_OPCODE_ID and not external) {
+            const Liveness &liveness = bases[out];
+            if (not liveness.live or is_shadowed(instr.operand[0], liveness.shadows)) {
+                const vector<int64_t> shape = instr.shape();
+                work += bh_nelements(shape.size(), &shape[0]);
+                ++num_removed;
+                instr.opcode = BH_NONE;
+                continue;
+            }
+        }
+
+        // The output view is overwritten by this instruction unless it is only updated partially
+        if (not bh_opcode_is_system(instr.opcode) and instr.opcode <= BH_MAX_OPCODE_ID and
+            instr.opcode != BH_SCATTER and instr.opcode != BH_COND_SCATTER) {
+            bases[out].shadows.push_back(instr.operand[0]);
+        }
+        // And the inputs are read
+        for (size_t o = bh_opcode_is_system(instr.opcode) ? 0 : 1; o < instr.operand.size(); ++o) {
+            const bh_view &view = instr.operand[o];
+            if (not bh_is_constant(&view)) {
+                bases[view.base].live = true;
+                bases[view.base].shadows.clear();
+            }
+        }
+    }
+    num_dead_ += num_removed;
+    dead_work_ += work;
+    if (num_removed > 0) {
+        verbose_print("[Dead] Removed " + std::to_string(num_removed) + " instructions saving " +
+                      std::to_string(work) + " element operations");
+    }
+}
+
+}}}
@@ -17,6 +17,10 @@ GNU Lesser General Public License along with Bohrium.
 
 If not, see <http://www.gnu.org/licenses/>.
 */
+#include <algorithm>
+
+#include <bh_util.hpp>
+
 #include "contracter.hpp"
 
 using namespace std;
@@ -25,95 +29,155 @@ namespace bohrium {
 namespace filter {
 namespace bccon {
 
-static void rewrite_chain(vector<bh_instruction*>& links, bh_instruction* &first, bh_instruction* &last)
+// Is 'opcode' a reduction that we can apply over several axes at once?
+static inline bool is_multi_axis_reduction(bh_opcode opcode)
 {
-    // Rewrite the first reduction as a "COMPLETE" REDUCE.
-    // Copy the meta-data of the SCALAR output from the last REDUCE
-    first->operand[0] = last->operand[0];
-
-    // Set the last reduction to NONE, it no longer needs execution.
-    last->opcode = BH_NONE;
-
-    // Set all the instructions "links" in the chain as BH_NONE
-    // they no longer need execution.
-    vector<bh_instruction*>::iterator rit;
-    for(rit = links.begin(); rit != links.end(); ++rit) {
-        bh_instruction& rinstr = **rit;
-        rinstr.opcode = BH_NONE;
-    }
+    return bh_opcode_is_reduction(opcode) and opcode != BH_ARG_MAXIMUM_REDUCE and opcode != BH_ARG_MINIMUM_REDUCE;
 }
 
-void Contracter::reduction(BhIR &bhir)
+// Returns the index of the first instruction after 'pc' that accesses 'base' or the size of 'instr_list'
+static size_t next_access(const vector<bh_instruction> &instr_list, size_t pc, const bh_base *base)
 {
-    bh_opcode reduce_opcode = BH_NONE;
-    bh_instruction* first;
-    bh_instruction* last;
+    for (size_t i = pc+1; i < instr_list.size(); ++i) {
+        if (instr_list[i].opcode == BH_NONE) {
+            continue;
+        }
+        for (const bh_view &view: instr_list[i].operand) {
+            if (not bh_is_constant(&view) and view.base == base) {
+                return i;
+            }
+        }
+    }
+    return instr_list.size();
+}
 
-    std::set<const bh_base*> bases;
+// Merges the axes [first, last] of 'view' into the axis 'first'. Returns false when the strides doesn't allow it.
+static bool merge_axes(bh_view &view, int64_t first, int64_t last)
+{
+    for (int64_t i = first; i < last; ++i) {
+        if (view.stride[i] != view.stride[i+1] * view.shape[i+1]) {
+            return false;
+        }
+    }
+    for (int64_t i = first+1; i <= last; ++i) {
+        view.shape[first] *= view.shape[i];
+    }
+    view.stride[first] = view.stride[last];
+    const int64_t nmerged = last - first;
+    for (int64_t i = last+1; i < view.ndim; ++i) {
+        view.shape[i - nmerged] = view.shape[i];
+        view.stride[i - nmerged] = view.stride[i];
+    }
+    view.ndim -= nmerged;
+    return true;
+}
 
-    // Instructions in the chain that are not, the first and the last reduction.
-    vector<bh_instruction*> links;
+/*
+We are looking for chains of reductions such as:
 
-    for(size_t pc = 0; pc < bhir.instr_list.size(); ++pc) {
-        bh_instruction& instr = bhir.instr_list[pc];
+  BH_ADD_REDUCE a1[0:30,0:40] a0[0:30,0:40,0:50] 2
+  BH_ADD_REDUCE a2[0:30] a1[0:30,0:40] 1
+  BH_ADD_REDUCE a3[0:1] a2[0:30] 0
+  BH_FREE a1
+  BH_FREE a2
 
-        // Look for the "first" reduction in a chain of reductions
-        if (bh_opcode_is_reduction(instr.opcode) and instr.operand[0].base->nelem > 1) {
-            reduce_opcode = instr.opcode;
-            bases.insert(instr.operand[0].base);
+which is how the bridge reduces several axes. When the reduced axes are adjacent and their strides
+allow it, we rewrite the chain into one reduction over the merged axes:
 
-            first = &instr;
-            last  = NULL;
+  BH_ADD_REDUCE a3[0:1] a0[0:60000] 0
 
-            for(size_t pc_chain = pc+1; pc_chain < bhir.instr_list.size(); ++pc_chain) {
-                bh_instruction& other_instr = bhir.instr_list[pc_chain];
+This way, a full reduction becomes a single 1D reduction that is parallelized over all elements
+and no intermediate arrays are needed.
+*/
 
-                bool other_use = false;
-                for(bh_view &other_view: other_instr.operand) {
-                    if (bh_is_constant(&other_view)) {
-                        continue;
-                    }
+void Contracter::reduction(BhIR &bhir)
+{
+    vector<bh_instruction> &instr_list = bhir.instr_list;
+    for(size_t pc = 0; pc < instr_list.size(); ++pc) {
+        const bh_instruction& first = instr_list[pc];
+        if (not is_multi_axis_reduction(first.opcode) or bh_is_constant(&first.operand[1])) {
+            continue;
+        }
+        const bh_view &in = first.operand[1];
 
-                    if (bases.find(other_view.base) != bases.end()) {
-                        other_use = true;
-                        break;
-                    }
-                }
+        // The original axes of 'in' that remain after each reduction of the chain
+        vector<int64_t> remaining;
+        for (int64_t i = 0; i < in.ndim; ++i) {
+            remaining.push_back(i);
+        }
+        vector<int64_t> reduced = {remaining[first.sweep_axis()]};
+        remaining.erase(remaining.begin() + first.sweep_axis());
+
+        // The reductions and frees of the chain except the first reduction
+        vector<size_t> links;
+        size_t last = pc;
+        while (true) {
+            const bh_view &out = instr_list[last].operand[0];
+            if (remaining.empty() or not is_whole_base(out) or util::exist(bhir._syncs, out.base) or
+                out.base == bhir.getRepeatCondition()) {
+                break;
+            }
+            // The output must be reduced by the next reduction of the chain and then freed
+            const size_t next = next_access(instr_list, last, out.base);
+            if (next == instr_list.size()) {
+                break;
+            }
+            const bh_instruction &instr = instr_list[next];
+            if (instr.opcode != first.opcode or instr.operand[1] != out or instr.operand[0].base == out.base) {
+                break;
+            }
+            const size_t free = next_access(instr_list, next, out.base);
+            if (free == instr_list.size() or instr_list[free].opcode != BH_FREE) {
+                break;
+            }
+            reduced.push_back(remaining[instr.sweep_axis()]);
+            remaining.erase(remaining.begin() + instr.sweep_axis());
+            links.push_back(next);
+            links.push_back(free);
+            last = next;
+        }
+        if (links.empty()) {
+            continue;
+        }
 
-                if (!other_use) {
-                    continue;
-                }
+        // The reduced axes must be adjacent
+        std::sort(reduced.begin(), reduced.end());
+        if (reduced.back() - reduced.front() + 1 != static_cast<int64_t>(reduced.size())) {
+            continue;
+        }
+        bh_view merged = in;
+        if (not merge_axes(merged, reduced.front(), reduced.back())) {
+            continue;
+        }
 
-                bool is_none    = other_instr.opcode == BH_NONE;
-                bool is_freed   = other_instr.opcode == BH_FREE;
-                bool is_reduced = other_instr.opcode == reduce_opcode;
-
-                if (!(is_none or is_freed or is_reduced)) {
-                    // Chain is broken - Reset the search
-                    first = NULL;
-                    break;
-                } else if (other_instr.operand[0].base->nelem == 1) {
-                    // Scalar output - End of the chain
-                    last = &other_instr;
-                } else {
-                    links.push_back(&other_instr);
-                    if (other_instr.opcode == reduce_opcode) {
-                        bases.insert(other_instr.operand[0].base);
-                    }
+        // The merged reduction is executed where the chain ends thus the input must not change before that.
+        // NB: an extension method might write to any of its operands.
+        bool input_written = false;
+        for (size_t i = pc+1; i < last and not input_written; ++i) {
+            const bh_instruction &instr = instr_list[i];
+            if (instr.opcode != BH_NONE and not instr.operand.empty() and instr.operand[0].base == in.base) {
+                input_written = true;
+            } else if (instr.opcode > BH_MAX_OPCODE_ID) {
+                for (const bh_view &view: instr.operand) {
+                    input_written = input_written or (not bh_is_constant(&view) and view.base == in.base);
                 }
             }
+        }
+        if (input_written) {
+            continue;
+        }
 
-            if (first and last) {
-                verbose_print("[Reduction] Rewriting chain of length " + std::to_string(links.size()));
-                rewrite_chain(links, first, last);
+        verbose_print("[Reduction] Merging a chain of " + std::to_string(reduced.size()) + " reductions");
+        num_reduction_ += reduced.size() - 1;
+        bh_instruction &result = instr_list[last];
+        result.operand[1] = merged;
+        result.constant.value.int64 = reduced.front();
+        result.constant.type = bh_type::INT64;
+        instr_list[pc].opcode = BH_NONE;
+        for (size_t i: links) {
+            if (i != last) {
+                instr_list[i].opcode = BH_NONE;
             }
-
-            // Reset the search
-            reduce_opcode = BH_NONE;
-            first         = NULL;
-            last          = NULL;
-            links.clear();
-            bases.clear();
         }
     }
 }
@@ -33,7 +33,9 @@ static inline bool is_multiplying_by_one(const bh_instruction& instr)
 
 static inline bool is_dividing_by_one(const bh_instruction& instr)
 {
+    // NB: 1/x isn't x
     return instr.opcode == BH_DIVIDE and
+           bh_is_constant(&instr.operand[2]) and
            instr.constant.get_double() == 1.0;
 }
 
@@ -45,7 +47,9 @@ static inline bool is_adding_zero(const bh_instruction& instr)
 
 static inline bool is_subtracting_zero(const bh_instruction& instr)
 {
+    // NB: 0-x isn't x
     return instr.opcode == BH_SUBTRACT and
+           bh_is_constant(&instr.operand[2]) and
            instr.constant.get_double() == 0.0;
 }
 
@@ -17,6 +17,8 @@ GNU Lesser General Public License along with Bohrium.
 
 If not, see <http://www.gnu.org/licenses/>.
 */
+#include <sstream>
+
 #include "contracter.hpp"
 
 using namespace std;
@@ -32,23 +34,81 @@ Contracter::Contracter(
     bool reduction,
     bool stupidmath,
     bool collect,
-    bool muladd)
+    bool muladd,
+    bool copy,
+    bool cse,
+    bool dead,
+    bool algebra,
+    std::set<std::string> algebra_rules)
     : repeats_(repeats),
       reduction_(reduction),
       stupidmath_(stupidmath),
       collect_(collect),
-      muladd_(muladd) {
+      muladd_(muladd),
+      copy_(copy),
+      cse_(cse),
+      dead_(dead),
+      algebra_(algebra),
+      algebra_rules_(std::move(algebra_rules)) {
             __verbose = verbose;
       }
 
 Contracter::~Contracter(void) {}
 
+bh_view Contracter::createTemp(const bh_view &meta)
+{
+    bh_base *base = new bh_base;
+    base->type = meta.base->type;
+    base->nelem = bh_nelements(meta);
+    base->data = nullptr;
+    temps_.emplace_back(base);
+
+    bh_view view = meta;
+    view.base = base;
+    view.start = 0;
+    bh_set_contiguous_stride(&view);
+    return view;
+}
+
+void Contracter::gc(void)
+{
+    temps_.clear();
+}
+
+std::string Contracter::statistic() const
+{
+    std::stringstream ss;
+    ss << "[bccon] Contractions:\n";
+    ss << "Common subexpressions:           " << num_cse_ << " instructions\n";
+    ss << "Dead computations:               " << num_dead_ << " instructions, "
+       << "saves " << dead_work_ << " operations\n";
+    ss << "Copy eliminations:               " << num_copy_ << " instructions\n";
+    ss << "Algebraic rewrites:              " << num_algebra_ << " instructions\n";
+    ss << "Merged reductions:               " << num_reduction_ << " instructions\n";
+    ss << "\n";
+    return ss.str();
+}
+
+void Contracter::resetStatistic()
+{
+    num_cse_ = 0;
+    num_dead_ = 0;
+    dead_work_ = 0;
+    num_copy_ = 0;
+    num_algebra_ = 0;
+    num_reduction_ = 0;
+}
+
 void Contracter::contract(BhIR& bhir)
 {
     if(reduction_)  reduction(bhir);
     if(stupidmath_) stupidmath(bhir);
+    if(algebra_)    algebra(bhir);
     if(collect_)    collect(bhir);
     if(muladd_)     muladd(bhir);
+    if(copy_)       copy(bhir);
+    if(cse_)        cse(bhir);
+    if(dead_)       dead(bhir);
 }
 
 void verbose_print(std::string str)
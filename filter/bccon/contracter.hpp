@@ -1,5 +1,12 @@
 #pragma once
 
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
 #include <bh_component.hpp>
 
 namespace bohrium {
@@ -9,25 +16,67 @@ namespace bccon {
 extern bool __verbose;
 extern void verbose_print(std::string str);
 
+// Is 'view' the whole of its base array in contiguous order?
+inline bool is_whole_base(const bh_view& view)
+{
+    return view.start == 0 and bh_is_contiguous(&view) and bh_nelements(view) == view.base->nelem;
+}
+
 class Contracter
 {
 public:
-    Contracter(bool verbose, bool repeats, bool reduction, bool stupidmath, bool collect, bool muladd);
+    Contracter(bool verbose, bool repeats, bool reduction, bool stupidmath, bool collect, bool muladd, bool copy, bool cse, bool dead,
+               bool algebra, std::set<std::string> algebra_rules);
 
     ~Contracter(void);
 
     void contract(BhIR& bhir);
 
+    // Should consecutive identical BhIRs be collapsed into repeats (see `RepeatFinder`)?
+    bool repeats() const { return repeats_; }
+
+    // The names of the rewrite rules of the algebraic simplification and whether they are enabled by default
+    static std::map<std::string, bool> algebra_rule_defaults();
+
+    // Create a temporary view with the shape of 'meta' and a new base array, which is deleted by `gc()`
+    bh_view createTemp(const bh_view &meta);
+
+    // Delete the temporary base arrays. Must be called when the BhIRs that uses them have been executed.
+    void gc(void);
+
+    // Pretty print the number of instructions that the contractions have removed or rewritten
+    std::string statistic() const;
+
+    // Reset the numbers of `statistic()`
+    void resetStatistic();
+
     void reduction(BhIR& bhir);
     void stupidmath(BhIR& bhir);
+    void algebra(BhIR& bhir);
     void collect(BhIR& bhir);
     void muladd(BhIR& bhir);
+    void copy(BhIR& bhir);
+    void cse(BhIR& bhir);
+    void dead(BhIR& bhir);
 private:
     bool repeats_;
     bool reduction_;
     bool stupidmath_;
     bool collect_;
     bool muladd_;
+    bool copy_;
+    bool cse_;
+    bool dead_;
+    bool algebra_;
+    std::set<std::string> algebra_rules_;
+    std::vector<std::unique_ptr<bh_base> > temps_;
+    // The number of instructions that each contraction has removed or rewritten
+    uint64_t num_cse_ = 0;
+    uint64_t num_dead_ = 0;
+    uint64_t num_copy_ = 0;
+    uint64_t num_algebra_ = 0;
+    uint64_t num_reduction_ = 0;
+    uint64_t dead_work_ = 0;
 };
 
 }}}
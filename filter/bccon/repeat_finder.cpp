@@ -0,0 +1,180 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <map>
+#include <set>
+#include <sstream>
+
+#include <bh_util.hpp>
+#include <jitk/fuser_cache.hpp>
+
+#include "contracter.hpp"
+#include "repeat_finder.hpp"
+
+using namespace std;
+
+namespace bohrium {
+namespace filter {
+namespace bccon {
+
+namespace {
+
+// Finds the temporary base arrays of 'instr_list' in order of first appearance. A temporary base array
+// is unallocated, written whole by its first access, and freed within 'instr_list'.
+// Returns false if 'instr_list' cannot be deferred, which is the case when it frees a non-temporary base array
+// or contains syncs or extension methods.
+bool find_temporaries(const vector<bh_instruction> &instr_list, vector<bh_base*> &temporaries) {
+    set<bh_base*> accessed;
+    vector<bh_base*> candidates;
+    set<bh_base*> freed;
+    for (const bh_instruction &instr: instr_list) {
+        if (instr.opcode == BH_NONE) {
+            continue;
+        }
+        if (instr.opcode == BH_FREE) {
+            bh_base *base = instr.operand[0].base;
+            if (not util::exist_linearly(candidates, base)) {
+                return false;
+            }
+            freed.insert(base);
+            continue;
+        }
+        if (bh_opcode_is_system(instr.opcode) or instr.opcode > BH_MAX_OPCODE_ID) {
+            return false;
+        }
+        for (size_t i = 1; i < instr.operand.size(); ++i) {
+            if (not bh_is_constant(&instr.operand[i])) {
+                accessed.insert(instr.operand[i].base);
+            }
+        }
+        const bh_view &out = instr.operand[0];
+        if (not util::exist(accessed, out.base)) {
+            accessed.insert(out.base);
+            if (out.base->data == nullptr and instr.opcode != BH_SCATTER and instr.opcode != BH_COND_SCATTER and
+                bh_nelements_nbcast(&out) == out.base->nelem) {
+                candidates.push_back(out.base);
+            }
+        }
+    }
+    for (bh_base *base: candidates) {
+        if (util::exist(freed, base)) {
+            temporaries.push_back(base);
+        }
+    }
+    return true;
+}
+
+// Replaces the base arrays of 'instr_list' using 'base_map'
+void remap_bases(vector<bh_instruction> &instr_list, const map<bh_base*, bh_base*> &base_map) {
+    for (bh_instruction &instr: instr_list) {
+        for (bh_view &view: instr.operand) {
+            if (not bh_is_constant(&view)) {
+                auto it = base_map.find(view.base);
+                if (it != base_map.end()) {
+                    view.base = it->second;
+                }
+            }
+        }
+    }
+}
+
+// Returns the structural hash of 'instr_list'
+size_t structural_hash(const vector<bh_instruction> &instr_list) {
+    vector<bh_instruction *> instr_ptrs;
+    for (const bh_instruction &instr: instr_list) {
+        instr_ptrs.push_back(const_cast<bh_instruction *>(&instr));
+    }
+    return jitk::hash_instr_list(instr_ptrs);
+}
+} // Anonymous Namespace
+
+void RepeatFinder::execute(BhIR &bhir, component::ComponentFace &child) {
+    vector<bh_base*> temporaries;
+    if (bhir.getNRepeats() != 1 or bhir.getRepeatCondition() != nullptr or bhir.instr_list.empty() or
+        not find_temporaries(bhir.instr_list, temporaries)) {
+        flush(child);
+        child.execute(&bhir);
+        return;
+    }
+    const size_t hash = structural_hash(bhir.instr_list);
+
+    // Is 'bhir' a repeat of the deferred instruction list?
+    if (_nrepeats > 0 and hash == _hash and temporaries.size() == _temporaries.size() and
+        bhir.instr_list.size() == _instr_list.size()) {
+        map<bh_base*, bh_base*> base_map;
+        for (size_t i = 0; i < temporaries.size(); ++i) {
+            base_map[temporaries[i]] = _temporaries[i].get();
+        }
+        vector<bh_instruction> instr_list(bhir.instr_list);
+        remap_bases(instr_list, base_map);
+        if (instr_list == _instr_list) {
+            ++_nrepeats;
+            if (not bhir.getSyncs().empty()) {
+                // The bridge expects the synced arrays when this call returns
+                set<bh_base*> syncs;
+                for (bh_base *base: bhir.getSyncs()) {
+                    if (not util::exist(base_map, base)) {
+                        syncs.insert(base);
+                    }
+                }
+                BhIR repeated(std::move(_instr_list), std::move(syncs), _nrepeats);
+                _instr_list.clear();
+                _nrepeats = 0;
+                child.execute(&repeated);
+                _temporaries.clear();
+            }
+            return;
+        }
+    }
+
+    // 'bhir' isn't a repeat, thus we execute the deferred instruction list and defer 'bhir' instead
+    flush(child);
+    if (not bhir.getSyncs().empty()) {
+        child.execute(&bhir);
+        return;
+    }
+    map<bh_base*, bh_base*> base_map;
+    for (bh_base *base: temporaries) {
+        _temporaries.emplace_back(new bh_base(*base));
+        base_map[base] = _temporaries.back().get();
+    }
+    _instr_list = std::move(bhir.instr_list);
+    remap_bases(_instr_list, base_map);
+    _hash = hash;
+    _nrepeats = 1;
+}
+
+void RepeatFinder::flush(component::ComponentFace &child) {
+    if (_nrepeats == 0) {
+        return;
+    }
+    if (_nrepeats > 1) {
+        stringstream ss;
+        ss << "Collapsed " << _nrepeats << " flushes of " << _instr_list.size() << " instructions into a repeat";
+        verbose_print(ss.str());
+    }
+    BhIR bhir(std::move(_instr_list), {}, _nrepeats);
+    _instr_list.clear();
+    _nrepeats = 0;
+    child.execute(&bhir);
+    // NB: the temporaries have been freed by the child
+    _temporaries.clear();
+}
+
+}}}
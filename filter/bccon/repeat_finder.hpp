@@ -0,0 +1,58 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <bh_component.hpp>
+
+namespace bohrium {
+namespace filter {
+namespace bccon {
+
+/* Finds consecutive flushes of identical instruction lists, such as the body of a Python loop, and
+ * collapses them into one repeated BhIR (see `BhIR::_nrepeats`).
+ *
+ * A BhIR without syncs is deferred until the next BhIR arrives. If the next BhIR is identical, it is
+ * counted as a repeat of the deferred BhIR otherwise the deferred BhIR is executed as is.
+ * The temporary base arrays, which a BhIR creates and frees, are replaced by base arrays owned by
+ * the finder since the bridge deletes them when the flush returns. Thus, the temporary arrays of
+ * consecutive flushes match each other.
+ */
+class RepeatFinder {
+public:
+    // Executes 'bhir' through 'child' or defers it
+    void execute(BhIR &bhir, component::ComponentFace &child);
+
+    // Executes the deferred BhIR, if any, through 'child'
+    void flush(component::ComponentFace &child);
+
+private:
+    // The deferred instruction list and its structural hash
+    std::vector<bh_instruction> _instr_list;
+    size_t _hash = 0;
+    // Number of times to repeat the deferred instruction list (zero when nothing is deferred)
+    uint64_t _nrepeats = 0;
+    // The temporary base arrays of the deferred instruction list in order of first appearance
+    std::vector<std::unique_ptr<bh_base> > _temporaries;
+};
+
+}}}
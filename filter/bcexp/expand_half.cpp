@@ -0,0 +1,121 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "expander.hpp"
+
+using namespace std;
+
+namespace bohrium {
+namespace filter {
+namespace bcexp {
+
+// Does 'instr' compute on the 16-bit float types? Conversions and moves of the 16-bit floats are
+// supported directly by the code generators.
+static bool is_half_computation(const bh_instruction &instr)
+{
+    if (bh_opcode_is_system(instr.opcode) or instr.opcode > BH_MAX_OPCODE_ID or instr.opcode == BH_IDENTITY) {
+        return false;
+    }
+    if ((instr.opcode == BH_GATHER or instr.opcode == BH_SCATTER or instr.opcode == BH_COND_SCATTER) and
+        instr.operand_type(0) == instr.operand_type(1)) {
+        return false;
+    }
+    // A select between two arrays only moves elements, but a 16-bit constant must be converted
+    if (instr.opcode == BH_WHERE and not bh_is_constant(&instr.operand[2]) and not bh_is_constant(&instr.operand[3])) {
+        return false;
+    }
+    for (size_t o = 0; o < instr.operand.size(); ++o) {
+        if (bh_type_is_half(instr.operand_type(o))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ *  Expand an instruction that computes on the 16-bit float types at the given PC into a single
+ *  precision computation, e.g. BH_ADD OUT, IN1, IN2 where all operands are FLOAT16 becomes:
+ *
+ *  IDENTITY, t1, IN1
+ *  IDENTITY, t2, IN2
+ *  ADD, t3, t1, t2
+ *  IDENTITY, OUT, t3
+ *  FREE, t1
+ *  FREE, t2
+ *  FREE, t3
+ *
+ *  where t1, t2, and t3 are FLOAT32 temporaries, which the fuser turns into scalars. Constants of the
+ *  16-bit float types become FLOAT32 constants.
+ *
+ *  Returns the number of instructions added.
+ */
+int Expander::expandHalf(BhIR& bhir, int pc)
+{
+    int start_pc = pc;
+    bh_instruction& composite = bhir.instr_list[pc];
+    if (not is_half_computation(composite)) {
+        return 0;
+    }
+    verbose_print("[Half] Expanding " + std::string(bh_opcode_text(composite.opcode)) + " to single precision");
+
+    // Lazy choice... no re-use just NOP it.
+    bh_instruction instr = composite;
+    composite.opcode = BH_NONE;
+
+    // A contiguous single precision temporary with the shape of 'view'
+    auto single_temp = [this](const bh_view &view) {
+        bh_view meta = view;
+        meta.start = 0;
+        bh_set_contiguous_stride(&meta);
+        return createTemp(meta, bh_type::FLOAT32, bh_nelements(meta));
+    };
+
+    vector<bh_view> temps;
+    for (size_t o = 1; o < instr.operand.size(); ++o) {
+        bh_view &view = instr.operand[o];
+        if (bh_is_constant(&view)) {
+            if (bh_type_is_half(instr.constant.type)) {
+                instr.constant = bh_constant(static_cast<float>(instr.constant.get_double()));
+            }
+        } else if (bh_type_is_half(view.base->type)) {
+            bh_view tmp = single_temp(view);
+            inject(bhir, ++pc, BH_IDENTITY, tmp, view);
+            temps.push_back(tmp);
+            view = tmp;
+        }
+    }
+
+    bh_view out = instr.operand[0];
+    if (bh_type_is_half(out.base->type)) {
+        bh_view tmp = single_temp(out);
+        instr.operand[0] = tmp;
+        inject(bhir, ++pc, instr);
+        inject(bhir, ++pc, BH_IDENTITY, out, tmp);
+        temps.push_back(tmp);
+    } else {
+        inject(bhir, ++pc, instr);
+    }
+
+    for (bh_view &tmp: temps) {
+        inject(bhir, ++pc, BH_FREE, tmp);
+    }
+    return pc - start_pc;
+}
+
+}}}
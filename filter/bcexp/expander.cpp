@@ -31,11 +31,13 @@ Expander::Expander(
     size_t threshold,
     int sign,
     int powk,
-    int reduce1d)
+    int reduce1d,
+    bool half)
     : gc_threshold_(threshold),
       sign_(sign),
       powk_(powk),
-      reduce1d_(reduce1d) {
+      reduce1d_(reduce1d),
+      half_(half) {
           __verbose = verbose;
       }
 
@@ -84,6 +86,16 @@ void Expander::expand(BhIR& bhir)
             break;
         }
     }
+
+    // The computations on the 16-bit float types, including those injected above, are done in single precision
+    if (half_) {
+        end = bhir.instr_list.size();
+        for(int pc=0; pc<end; ++pc) {
+            int increase = expandHalf(bhir, pc);
+            end += increase;
+            pc += increase;
+        }
+    }
 }
 
 size_t Expander::gc(void)
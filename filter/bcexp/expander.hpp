@@ -18,7 +18,7 @@ public:
     /**
      *  Construct the expander.
      */
-    Expander(bool verbose, size_t threshold, int sign, int powk, int reduce_1d);
+    Expander(bool verbose, size_t threshold, int sign, int powk, int reduce_1d, bool half);
 
     /**
      *  Tear down the expander.
@@ -83,6 +83,7 @@ public:
     int expandPowk(BhIR& bhir, int pc);
     int expandReduce1d(BhIR& bhir, int pc, int fold_limit);
     int expandRepeat(BhIR& bhir, int pc);
+    int expandHalf(BhIR& bhir, int pc);
 
 private:
     static const char TAG[];
@@ -91,6 +92,7 @@ private:
     int sign_;
     int powk_;
     int reduce1d_;
+    bool half_;
 };
 
 void Expander::inject(BhIR& bhir, int pc, bh_opcode opcode, bh_view& out, bh_view& in1, bh_view& in2)
@@ -182,6 +184,12 @@ inline void bh_set_constant(bh_instruction& instr, int opr_idx, bh_type type, T
             instr.constant.value.complex128.real = (double)value;
             instr.constant.value.complex128.imag = (double)0.0;
             break;
+        case bh_type::FLOAT16:
+            instr.constant.value.float16 = bh_float32_to_float16((float)value);
+            break;
+        case bh_type::BFLOAT16:
+            instr.constant.value.bfloat16 = bh_float32_to_bfloat16((float)value);
+            break;
         case bh_type::R123:
         default:
             fprintf(stderr, "set_constant unsupported for given type.");
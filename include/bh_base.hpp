@@ -39,6 +39,9 @@ struct bh_base
     // The number of elements in the array
     int64_t      nelem;
 
+    // Is the data of this boolean array bit-packed into 32-bit words (see `bh_data_unpack()`)?
+    bool         packed = false;
+
     // Returns an unique ID of this base array
     size_t get_label() const;
 
@@ -52,6 +55,7 @@ struct bh_base
         ar << tmp;
         ar & type;
         ar & nelem;
+        ar & packed;
     }
     template<class Archive>
     void load(Archive & ar, const unsigned int version)
@@ -61,6 +65,7 @@ struct bh_base
         data = (void*)tmp;
         ar & type;
         ar & nelem;
+        ar & packed;
     }
     BOOST_SERIALIZATION_SPLIT_MEMBER()
 };
@@ -91,3 +96,10 @@ DLLEXPORT void bh_data_malloc(bh_base* base);
  * @base    The base in question
  */
 void bh_data_free(bh_base* base);
+
+/* Converts the data of a bit-packed boolean array into one byte per element.
+ * For convenience, the base is allowed to be NULL or not packed.
+ *
+ * @base    The base in question
+ */
+DLLEXPORT void bh_data_unpack(bh_base* base);
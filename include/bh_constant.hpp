@@ -38,6 +38,8 @@ union bh_constant_value
     bh_complex64  complex64;
     bh_complex128 complex128;
     bh_r123       r123;
+    bh_float16    float16;
+    bh_bfloat16   bfloat16;
 
     // Constructors for each possible union type
     bh_constant_value() = default;
@@ -55,6 +57,8 @@ union bh_constant_value
     bh_constant_value(std::complex<float> val) : complex64{val.real(), val.imag()} {}
     bh_constant_value(std::complex<double> val) : complex128{val.real(), val.imag()} {}
     bh_constant_value(bh_r123 val) : r123(val) {}
+    bh_constant_value(bh_float16 val) : float16(val) {}
+    bh_constant_value(bh_bfloat16 val) : bfloat16(val) {}
 };
 
 class bh_constant
@@ -39,6 +39,8 @@ typedef double        bh_float64;
 typedef struct { float real, imag; } bh_complex64;
 typedef struct { double real, imag; } bh_complex128;
 typedef struct { bh_uint64 start, key; } bh_r123;
+typedef struct { bh_uint16 bits; } bh_float16;  // IEEE 754 half precision (storage only)
+typedef struct { bh_uint16 bits; } bh_bfloat16; // The upper half of an IEEE 754 single precision (storage only)
 
 /* Codes for data types */
 enum class bh_type
@@ -56,7 +58,9 @@ enum class bh_type
     FLOAT64,
     COMPLEX64,
     COMPLEX128,
-    R123
+    R123,
+    FLOAT16,
+    BFLOAT16
 };
 
 // Return a `bh_type` based on a template type
@@ -105,6 +109,12 @@ template<> inline bh_type bh_type_from_template<std::complex<double> >() {
 template<> inline bh_type bh_type_from_template<bh_r123>() {
     return bh_type::R123;
 }
+template<> inline bh_type bh_type_from_template<bh_float16>() {
+    return bh_type::FLOAT16;
+}
+template<> inline bh_type bh_type_from_template<bh_bfloat16>() {
+    return bh_type::BFLOAT16;
+}
 
 typedef int64_t    bh_opcode;
 
@@ -151,6 +161,13 @@ DLLEXPORT int bh_type_is_unsigned_integer(bh_type type);
  */
 DLLEXPORT int bh_type_is_float(bh_type type);
 
+/* Is type a 16-bit float type, which is stored in 16 bits but computed in single precision
+ *
+ * @type   The type.
+ * @return 1 if half precision type else 0.
+ */
+DLLEXPORT int bh_type_is_half(bh_type type);
+
 /* Is type an complex type
  *
  * @type   The type.
@@ -181,3 +198,11 @@ DLLEXPORT double bh_type_limit_max_float(bh_type type);
  * @type   The type.
  */
 DLLEXPORT double bh_type_limit_min_float(bh_type type);
+
+/* Conversion between single precision and the 16-bit float types.
+ * The conversion to 16 bits rounds to nearest even.
+ */
+DLLEXPORT float bh_float16_to_float32(bh_float16 val);
+DLLEXPORT bh_float16 bh_float32_to_float16(float val);
+DLLEXPORT float bh_bfloat16_to_float32(bh_bfloat16 val);
+DLLEXPORT bh_bfloat16 bh_float32_to_bfloat16(float val);
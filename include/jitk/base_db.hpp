@@ -92,6 +92,7 @@ private:
     std::vector<bh_base*> _params; // Vector of non-temporary arrays, which are the in-/out-puts of the JIT kernel
     std::set<bh_base*> _frees; // Set of freed arrays
     bool _useRandom; // Flag: is any instructions using random?
+    bool _useHalf; // Flag: is any instructions using the 16-bit float types?
 
 public:
     // Should we declare scalar variables using the volatile keyword?
@@ -100,6 +101,12 @@ public:
     const bool strides_as_var;
     // Should we save index calculations in variables?
     const bool index_as_var;
+    // Should we save the offset of each array at each loop level in variables, which the inner loops add to?
+    const bool offset_as_var;
+    // Should we load shifted views of the same array through a sliding window of variables in the innermost loops?
+    const bool sliding_window;
+    // Should we hoist the broadcast operands, and the instructions that only depend on them, out of the inner loops?
+    const bool hoist_broadcast;
     // Should we use constants as variables?
     const bool const_as_var;
 
@@ -108,11 +115,18 @@ public:
                 bool use_volatile,
                 bool strides_as_var,
                 bool index_as_var,
+                bool offset_as_var,
+                bool sliding_window,
+                bool hoist_broadcast,
                 bool const_as_var) :
         _useRandom(false),
+        _useHalf(false),
         use_volatile(use_volatile),
         strides_as_var(strides_as_var),
         index_as_var(index_as_var),
+        offset_as_var(offset_as_var),
+        sliding_window(sliding_window),
+        hoist_broadcast(hoist_broadcast),
         const_as_var(const_as_var) {
         // NB: by assigning the IDs in the order they appear in the 'instr_list',
         //     the kernels can better be reused
@@ -137,11 +151,16 @@ public:
                 }
             } else if (instr->opcode == BH_SCATTER or instr->opcode == BH_COND_SCATTER) {
                 _array_always.insert(instr->operand[0].base);
-            } else if (instr->opcode == BH_RANDOM) {
+            } else if (instr->opcode == BH_RANDOM or instr->opcode == BH_RANDOM_NORMAL) {
                 _useRandom = true;
             } else if (instr->opcode == BH_FREE) {
                 _frees.insert(instr->operand[0].base);
             }
+            for (size_t o = 0; o < instr->operand.size(); ++o) {
+                if (bh_type_is_half(instr->operand_type(o))) {
+                    _useHalf = true;
+                }
+            }
             // Find bases that are the parameters to the JIT kernel, which are non-temporary arrays not
             // already in `_params`. NB: the order of `_params` matches the order of the array IDs
             for(const bh_view &v: instr->operand) {
@@ -222,6 +241,31 @@ public:
     bool useRandom() const {
         return _useRandom;
     }
+    // Is any instructions use the 16-bit float types?
+    bool useHalf() const {
+        return _useHalf;
+    }
+    // Is any of the kernel parameters a bit-packed boolean array?
+    // NB: the engine decides the packing after the creation of the symbol table
+    bool usePacked() const {
+        for (const bh_base *base: _params) {
+            if (base->packed) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// A sliding window of an innermost loop, which is input views of the same array that are shifted a whole number
+// of iterations along the loop. Each element is loaded once into the window, which rotates every iteration.
+struct SlidingWindow {
+    // The views and their shift, which is the number of iterations a view is ahead of the first view
+    std::vector<std::pair<const bh_view*, int64_t> > views;
+    // The number of variables in the window
+    int64_t size() const {
+        return views.back().second + 1;
+    }
 };
 
 class Scope {
@@ -237,6 +281,10 @@ private:
     std::set<bh_base*> _declared_base; // Set of bases that have been locally declared (e.g. a temporary variable)
     std::set<bh_view> _declared_view; // Set of views that have been locally declared (e.g. a temporary variable)
     std::set<bh_view, idx_less> _declared_idx; // Set of indexes that have been locally declared
+    std::map<bh_view, int, OffsetAndStrides_less> _declared_offset; // Map of offsets to the rank of their declaration
+    std::map<bh_view, std::pair<size_t, int64_t> > _sliding_window; // Map of views to their window ID and shift
+    std::set<const bh_instruction*> _hoisted_instr; // Set of instructions that an enclosing loop has computed
+    std::vector<bh_view> _streamed; // Vector of outputs that are written with non-temporal stores
 public:
     template<typename T1, typename T2>
     Scope(const SymbolTable &symbols,
@@ -313,9 +361,52 @@ public:
         return isScalarReplaced_R(view) or isScalarReplaced_RW(view.base);
     }
 
+    // Insert the views of 'window', which is named after the ID of its first view
+    void insertSlidingWindow(const SlidingWindow &window) {
+        const size_t id = symbols.viewID(*window.views[0].first);
+        for (const auto &view: window.views) {
+            _sliding_window[*view.first] = std::make_pair(id, view.second);
+        }
+    }
+    // Check if 'view' is loaded through a sliding window
+    bool isSlidingWindow(const bh_view &view) const {
+        if (util::exist(_sliding_window, view)) {
+            return true;
+        } else if (parent != NULL) {
+            return parent->isSlidingWindow(view);
+        } else {
+            return false;
+        }
+    }
+
+    // Insert and check if 'instr' has been hoisted out of the loop, i.e. computed before the loop
+    void insertHoistedInstr(const bh_instruction &instr) {
+        _hoisted_instr.insert(&instr);
+    }
+    bool isHoistedInstr(const bh_instruction &instr) const {
+        if (_hoisted_instr.find(&instr) != _hoisted_instr.end()) {
+            return true;
+        } else if (parent != NULL) {
+            return parent->isHoistedInstr(instr);
+        } else {
+            return false;
+        }
+    }
+
+    // Insert and get the outputs of this loop that are written with non-temporal stores. Within the loop body,
+    // the outputs are scalar replaced and the loop writes the scalars to the arrays.
+    void insertStreamed(const bh_view &view) {
+        assert(not isTmp(view.base) and not isScalarReplaced(view));
+        _scalar_replacements_rw.insert(view.base);
+        _streamed.push_back(view);
+    }
+    const std::vector<bh_view> &getStreamed() const {
+        return _streamed;
+    }
+
     // Check if 'view' is a regular array (not temporary, scalar-replaced etc.)
     bool isArray(const bh_view &view) const {
-        return not (isTmp(view.base) or isScalarReplaced(view));
+        return not (isTmp(view.base) or isScalarReplaced(view) or isSlidingWindow(view));
     }
 
     // Insert and check if 'base' should be guarded by OpenMP atomic
@@ -390,6 +481,13 @@ public:
             if (isScalarReplaced_R(view)) {
                 out << "_" << symbols.viewID(view);;
             }
+        } else if (isSlidingWindow(view)) {
+            const Scope *scope = this;
+            while (not util::exist(scope->_sliding_window, view)) {
+                scope = scope->parent;
+            }
+            const std::pair<size_t, int64_t> &window = scope->_sliding_window.at(view);
+            getWindowName(window.first, window.second, out);
         } else {
             out << "a" << symbols.baseID(view.base);
         }
@@ -420,6 +518,24 @@ public:
         }
     }
 
+    // Get the name (symbol) of the variable of 'shift' in the sliding window 'id'
+    template <typename T>
+    void getWindowName(size_t id, int64_t shift, T &out) const {
+        out << "w" << id << "_" << shift;
+    }
+
+    // Get the rank of the innermost loop where the offset of 'view' has been declared or -1 if it hasn't
+    int offsetRank(const bh_view &view) const {
+        auto it = _declared_offset.find(view);
+        if (it != _declared_offset.end()) {
+            return it->second;
+        } else if (parent != NULL) {
+            return parent->offsetRank(view);
+        } else {
+            return -1;
+        }
+    }
+
     // Get the name (symbol) of the 'base'
     template <typename T>
     void getIdxName(const bh_view &view, T &out) const {
@@ -433,6 +549,16 @@ public:
 
     // Write the variable declaration of the index calculation of 'view' using 'type_str' as the type string
     void writeIdxDeclaration(const bh_view &view, const std::string &type_str, std::stringstream &out);
+
+    // Get the name (symbol) of the offset of 'view' in the loop of 'rank'
+    template <typename T>
+    void getOffsetName(const bh_view &view, int rank, T &out) const {
+        out << "vo" << symbols.offsetStridesID(view) << "_i" << rank;
+    }
+
+    // Write the variable declaration of the offset of 'view' in the loop of 'rank', which is the offset in the
+    // enclosing loop plus the iterator of 'rank' times its stride
+    void writeOffsetDeclaration(const bh_view &view, int rank, const std::string &type_str, std::stringstream &out);
 };
 
 
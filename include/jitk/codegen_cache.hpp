@@ -42,10 +42,13 @@ public:
     // Check the cache for a source code that matches 'instr_list'
     // Returns the source code and the hash of the source.
     // On cache misses, the returned source is an empty string.
-    std::pair<std::string, uint64_t> get(const std::vector<Block> &block_list, const SymbolTable &symbols);
+    // 'seed' distinguishes kernels of the same 'block_list' that are written differently (e.g. with a repeat loop)
+    std::pair<std::string, uint64_t> get(const std::vector<Block> &block_list, const SymbolTable &symbols,
+                                         uint64_t seed = 0);
 
     // Insert 'source' as a hit when requesting 'block_list'
-    void insert(std::string source, const std::vector<Block> &block_list, const SymbolTable &symbols);
+    void insert(std::string source, const std::vector<Block> &block_list, const SymbolTable &symbols,
+                uint64_t seed = 0);
 };
 
 
@@ -91,6 +91,21 @@ inline std::vector<const bh_view*> scalar_replaced_input_only(const LoopB &block
     return result;
 }
 
+// The repeat loop of a kernel that runs its instructions `nrepeats` times in one call (see `BhIR::_nrepeats`)
+struct KernelRepeat {
+    // Number of times to run the kernel body
+    uint64_t nrepeats = 1;
+    // Stop repeating when this single BH_BOOL element is false. NB: nullptr means never stop
+    bh_base *condition = nullptr;
+    // Number of repeats fused into one wavefront sweep (temporal blocking). NB: one means no temporal blocking
+    uint64_t nsteps = 1;
+    // The wavefront shift of each loop instance (see `temporal_blocking_shifts()`)
+    std::vector<int64_t> shifts;
+
+    // Does the kernel have a repeat loop?
+    bool enabled() const { return nrepeats > 1; }
+};
+
 // Returns the filename of a the given hashes and file extension
 // compilation_hash is the hash of the compile command and source_hash is the hash of the source code
 std::string hash_filename(uint64_t compilation_hash, size_t source_hash, std::string file_extension);
@@ -104,6 +119,10 @@ boost::filesystem::path write_source2file(const std::string &src,
 // Returns the path to the tmp dir
 boost::filesystem::path get_tmp_path(const ConfigParser &config);
 
+// Returns the minimum size in bytes of the arrays that the innermost loops write with non-temporal stores, which is
+// the size of the last-level cache when the `streaming_store_threshold` option is zero. Returns zero when disabled.
+uint64_t get_streaming_store_threshold(const ConfigParser &config);
+
 // Tries five times to create directories recursively
 // Useful when multiple processes runs on the same filesystem
 void create_directories(const boost::filesystem::path &path);
@@ -116,6 +135,44 @@ std::vector<InstrPtr> order_sweep_set(const std::set<InstrPtr> &sweep_set, const
 // Return pair (global work size, local work size)
 std::pair<uint32_t, uint32_t> work_ranges(uint64_t work_group_size, int64_t block_size);
 
+// Assigns the kernel temporaries to buffers. Temporaries of the same type and size share a buffer when the
+// top-level blocks of 'block_list' that access them don't overlap.
+// Returns the buffer index of each temporary in 'kernel_temps'
+std::vector<size_t> kernel_temp_buffers(const std::vector<Block> &block_list,
+                                        const std::vector<bh_base*> &kernel_temps);
+
+// Returns the sliding windows of the innermost loop 'block', which are input views of arrays that 'block' doesn't
+// write. A window consists of at least two views of the same array and is at most `max_window` variables wide.
+// NB: when 'parent_scope' is NULL, the views that an outer loop scalar replaces are also included
+std::vector<SlidingWindow> sliding_windows(const LoopB &block, const Scope *parent_scope,
+                                           const std::set<bh_base*> &local_tmps, int64_t max_window = 8);
+
+// Returns the outputs of the innermost loop 'block' that should be written with non-temporal stores, which are the
+// contiguous arrays of at least 'threshold' bytes that 'block' overwrites completely without reading them first
+// NB: when 'parent_scope' is NULL, the views that an outer loop scalar replaces are also included
+std::vector<const bh_view*> streamed_outputs(const SymbolTable &symbols, const LoopB &block, const Scope *parent_scope,
+                                             uint64_t threshold);
+
+// The operands of a loop that don't change between its iterations, which the enclosing loop can load and compute once
+// per iteration of its own
+struct LoopInvariants {
+    // Input views that are broadcast along the loop and its inner loops (i.e. their strides are zero)
+    std::vector<const bh_view*> views;
+    // Element-wise instructions of the loop that write a local temporary array and only read constants, the
+    // invariant views, and the outputs of preceding invariant instructions
+    std::vector<InstrPtr> instrs;
+    // The temporary arrays that 'instrs' write
+    std::set<bh_base*> tmps;
+
+    bool empty() const {
+        return views.empty() and instrs.empty();
+    }
+};
+
+// Returns the invariants of 'block', which is a loop within the loop of 'parent_scope'. The views of arrays that
+// 'block' writes are not invariant and neither are views that 'parent_scope' has already made scalars.
+LoopInvariants loop_invariants(const LoopB &block, const Scope &parent_scope);
+
 // Sets the constructor flag of each instruction in 'instr_list'
 // 'remotely_allocated_bases' is a collection of array bases already remotely allocated
 template<typename T>
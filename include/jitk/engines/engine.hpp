@@ -157,11 +157,24 @@ protected:
             }
         }
 
-        // Let's scalar replace input-only arrays that are used multiple times
-        vector<const bh_view*> srio = scalar_replaced_input_only(block, parent_scope, local_tmps);
+        // Let's load shifted views of the same array through sliding windows when the innermost loop is sequential
+        const vector<SlidingWindow> windows = getSlidingWindows(symbols, block, parent_scope, thread_stack);
+
+        // Let's scalar replace input-only arrays that are used multiple times, except the views that the innermost
+        // loops load through sliding windows
+        const vector<SlidingWindow> nested_windows = getNestedSlidingWindows(symbols, block, thread_stack);
+        vector<const bh_view*> srio;
+        for (const bh_view *view: scalar_replaced_input_only(block, parent_scope, local_tmps)) {
+            if (not inSlidingWindows(nested_windows, *view)) {
+                srio.push_back(view);
+            }
+        }
 
         // And then create the scope
         jitk::Scope scope(symbols, parent_scope, local_tmps, scalar_replaced_reduction_outputs, srio);
+        for (const SlidingWindow &window: windows) {
+            scope.insertSlidingWindow(window);
+        }
 
         // When a reduction output is a scalar (e.g. because of array contraction or scalar replacement),
         // it should be declared before the for-loop
@@ -177,8 +190,22 @@ protected:
             }
         }
 
-        // Find indexes we will declare later
+        // A reduction of a bit-packed boolean array is done a word at a time
+        if (not opencl) {
+            const bh_view *packed_input = packedReduction(block, scope);
+            if (packed_input != nullptr) {
+                writePackedReduction(scope, block, *packed_input, out);
+                writeReductionCopyBack(symbols, scope, block, scalar_replaced_reduction_outputs, out);
+                return;
+            }
+        }
+
+        // The windows are declared and filled with the elements of the first iteration before the for-loop
+        writeSlidingWindowDeclarations(scope, block, windows, out);
+
+        // Find indexes and offsets we will declare later
         vector<const bh_view*> indexes = getIndexes(block, scope, symbols);
+        vector<const bh_view*> offsets = getOffsets(block, scope, symbols);
 
         // We might not have to loop "peel" if all reduction have an identity value and writes to a scalar
         bool peel = needToPeel(ordered_block_sweeps, scope);
@@ -233,15 +260,15 @@ protected:
                         } else if (peeled_scope.isScalarReplaced_R(*view)) {
                             util::spaces(out, 8 + block.rank * 4);
                             peeled_scope.writeDeclaration(*view, writeType(view->base->type), out);
-                            out << " " << peeled_scope.getName(*view) << " = a" << symbols.baseID(view->base);
-                            write_array_subscription(peeled_scope, *view, out);
+                            out << " " << peeled_scope.getName(*view) << " = ";
+                            write_array_access(peeled_scope, *view, out);
                             out << ";";
                             out << "\n";
                         }
                     }
                 }
             }
-            // Write the indexes declarations
+            // Write the indexes and offsets declarations
             for (const bh_view *view: indexes) {
                 if (not peeled_scope.isIdxDeclared(*view)) {
                     util::spaces(out, 8 + block.rank * 4);
@@ -249,17 +276,25 @@ protected:
                     out << "\n";
                 }
             }
+            for (const bh_view *view: offsets) {
+                util::spaces(out, 8 + block.rank * 4);
+                peeled_scope.writeOffsetDeclaration(*view, block.rank, writeType(bh_type::UINT64), out);
+                out << "\n";
+            }
+            writeSlidingWindowLoads(peeled_scope, block, windows, out);
             out << "\n";
             for (const Block &b: peeled_block._block_list) {
                 if (b.isInstr()) {
-                    if (b.getInstr() != nullptr and not bh_opcode_is_system(b.getInstr()->opcode)) {
+                    if (b.getInstr() != nullptr and not bh_opcode_is_system(b.getInstr()->opcode) and
+                        not peeled_scope.isHoistedInstr(*b.getInstr())) {
                         util::spaces(out, 4 + b.rank()*4);
                         write_instr(peeled_scope, *b.getInstr(), out, opencl);
                     }
                 } else {
-                    writeLoopBlock(symbols, &peeled_scope, b.getLoop(), thread_stack, opencl, out);
+                    writeInnerLoopBlock(symbols, peeled_scope, b.getLoop(), thread_stack, opencl, out);
                 }
             }
+            writeSlidingWindowRotations(peeled_scope, block, windows, out);
             util::spaces(out, 4 + block.rank*4);
             out << "}\n";
         }
@@ -279,15 +314,15 @@ protected:
                     } else if (scope.isScalarReplaced_R(*view)) {
                         util::spaces(out, 8 + block.rank * 4);
                         scope.writeDeclaration(*view, writeType(view->base->type), out);
-                        out << " " << scope.getName(*view) << " = a" << symbols.baseID(view->base);
-                        write_array_subscription(scope, *view, out);
+                        out << " " << scope.getName(*view) << " = ";
+                        write_array_access(scope, *view, out);
                         out << ";";
                         out << "\n";
                     }
                 }
             }
         }
-        // Write the indexes declarations
+        // Write the indexes and offsets declarations
         for (const bh_view *view: indexes) {
             if (not scope.isIdxDeclared(*view)) {
                 util::spaces(out, 8 + block.rank * 4);
@@ -295,25 +330,32 @@ protected:
                 out << "\n";
             }
         }
+        for (const bh_view *view: offsets) {
+            util::spaces(out, 8 + block.rank * 4);
+            scope.writeOffsetDeclaration(*view, block.rank, writeType(bh_type::UINT64), out);
+            out << "\n";
+        }
+        writeSlidingWindowLoads(scope, block, windows, out);
 
         // Write the for-loop body
         // The body in OpenCL and OpenMP are very similar but OpenMP might need to insert "#pragma omp atomic/critical"
         if (opencl) {
             for (const Block &b: block._block_list) {
                 if (b.isInstr()) { // Finally, let's write the instruction
-                    if (b.getInstr() != NULL and not bh_opcode_is_system(b.getInstr()->opcode)) {
+                    if (b.getInstr() != NULL and not bh_opcode_is_system(b.getInstr()->opcode) and
+                        not scope.isHoistedInstr(*b.getInstr())) {
                         util::spaces(out, 4 + b.rank()*4);
                         write_instr(scope, *b.getInstr(), out, true);
                     }
                 } else {
-                    writeLoopBlock(symbols, &scope, b.getLoop(), thread_stack, opencl, out);
+                    writeInnerLoopBlock(symbols, scope, b.getLoop(), thread_stack, opencl, out);
                 }
             }
         } else {
             for (const Block &b: block._block_list) {
                 if (b.isInstr()) { // Finally, let's write the instruction
                     const InstrPtr instr = b.getInstr();
-                    if (not bh_opcode_is_system(instr->opcode)) {
+                    if (not bh_opcode_is_system(instr->opcode) and not scope.isHoistedInstr(*instr)) {
                         if (instr->operand.size() > 0) {
                             if (scope.isOpenmpAtomic(instr->operand[0])) {
                                 util::spaces(out, 4 + b.rank()*4);
@@ -327,14 +369,38 @@ protected:
                         write_instr(scope, *instr, out);
                     }
                 } else {
-                    writeLoopBlock(symbols, &scope, b.getLoop(), thread_stack, opencl, out);
+                    writeInnerLoopBlock(symbols, scope, b.getLoop(), thread_stack, opencl, out);
                 }
             }
         }
+        writeSlidingWindowRotations(scope, block, windows, out);
+        loopTailWriter(symbols, scope, block, out);
         util::spaces(out, 4 + block.rank*4);
         out << "}\n";
 
-        // Let's copy the scalar replaced reduction outputs back to the original array
+        writeReductionCopyBack(symbols, scope, block, scalar_replaced_reduction_outputs, out);
+    }
+
+    virtual void loopHeadWriter(const SymbolTable &symbols,
+                                Scope &scope,
+                                const LoopB &block,
+                                bool loop_is_peeled,
+                                const std::vector<uint64_t> &thread_stack,
+                                std::stringstream &out) = 0;
+
+    // Writes the end of the for-loop body that the header of `loopHeadWriter()` might need (e.g. closing an inner loop)
+    virtual void loopTailWriter(const SymbolTable &symbols,
+                                const Scope &scope,
+                                const LoopB &block,
+                                std::stringstream &out) {}
+
+private:
+    // Let's copy the scalar replaced reduction outputs back to the original array
+    void writeReductionCopyBack(const jitk::SymbolTable &symbols,
+                                const jitk::Scope &scope,
+                                const jitk::LoopB &block,
+                                const std::vector<const bh_view*> &scalar_replaced_reduction_outputs,
+                                std::stringstream &out) {
         for (const bh_view *view: scalar_replaced_reduction_outputs) {
             util::spaces(out, 4 + block.rank*4);
             out << "a" << symbols.baseID(view->base);
@@ -345,14 +411,241 @@ protected:
         }
     }
 
-    virtual void loopHeadWriter(const SymbolTable &symbols,
-                                Scope &scope,
-                                const LoopB &block,
-                                bool loop_is_peeled,
-                                const std::vector<uint64_t> &thread_stack,
-                                std::stringstream &out) = 0;
+    // Writes the loop 'block' within the loop of 'scope'. The broadcast views of 'block' are loaded, and the
+    // instructions that only depend on them are computed, before 'block' in a scope of their own.
+    void writeInnerLoopBlock(const SymbolTable &symbols, const Scope &scope, const LoopB &block,
+                             const std::vector<uint64_t> &thread_stack, bool opencl, std::stringstream &out) {
+        if (not symbols.hoist_broadcast or block.isSystemOnly()) {
+            writeLoopBlock(symbols, &scope, block, thread_stack, opencl, out);
+            return;
+        }
+        const LoopInvariants invariants = loop_invariants(block, scope);
+        if (invariants.empty()) {
+            writeLoopBlock(symbols, &scope, block, thread_stack, opencl, out);
+            return;
+        }
+        Scope hoisted_scope(symbols, &scope, invariants.tmps, std::vector<const bh_view*>(), invariants.views);
+        for (const bh_view *view: invariants.views) {
+            util::spaces(out, 4 + block.rank * 4);
+            hoisted_scope.writeDeclaration(*view, writeType(view->base->type), out);
+            out << " " << hoisted_scope.getName(*view) << " = ";
+            write_hoisted_array_access(hoisted_scope, *view, block.rank - 1, out);
+            out << ";\n";
+        }
+        for (const InstrPtr &instr: invariants.instrs) {
+            util::spaces(out, 4 + block.rank * 4);
+            hoisted_scope.writeDeclaration(instr->operand[0], writeType(instr->operand[0].base->type), out);
+            out << "\n";
+            util::spaces(out, 4 + block.rank * 4);
+            write_instr(hoisted_scope, *instr, out, opencl);
+            hoisted_scope.insertHoistedInstr(*instr);
+        }
+        writeLoopBlock(symbols, &hoisted_scope, block, thread_stack, opencl, out);
+    }
+
+    // Returns the sliding windows of 'block' when it is an innermost loop that isn't parallelized
+    static std::vector<SlidingWindow> getSlidingWindows(const SymbolTable &symbols, const LoopB &block,
+                                                        const Scope *parent_scope,
+                                                        const std::vector<uint64_t> &thread_stack) {
+        if (symbols.sliding_window and block.isInnermost() and
+            block.rank >= std::max(1, static_cast<int>(thread_stack.size()))) {
+            return sliding_windows(block, parent_scope, block.getLocalTemps());
+        }
+        return {};
+    }
+
+    // Returns the sliding windows of the innermost loops within 'block' (including 'block' itself)
+    static std::vector<SlidingWindow> getNestedSlidingWindows(const SymbolTable &symbols, const LoopB &block,
+                                                              const std::vector<uint64_t> &thread_stack) {
+        std::vector<SlidingWindow> ret = getSlidingWindows(symbols, block, nullptr, thread_stack);
+        for (const Block &b: block._block_list) {
+            if (not b.isInstr()) {
+                for (SlidingWindow &window: getNestedSlidingWindows(symbols, b.getLoop(), thread_stack)) {
+                    ret.push_back(std::move(window));
+                }
+            }
+        }
+        return ret;
+    }
+
+    // Is 'view' in any of the sliding 'windows'?
+    static bool inSlidingWindows(const std::vector<SlidingWindow> &windows, const bh_view &view) {
+        for (const SlidingWindow &window: windows) {
+            for (const auto &v: window.views) {
+                if (*v.first == view) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Writes the variables of the sliding 'windows' and loads the elements of the first iteration of 'block'
+    // except the last element, which the loop body loads
+    void writeSlidingWindowDeclarations(const Scope &scope, const LoopB &block,
+                                        const std::vector<SlidingWindow> &windows, std::stringstream &out) {
+        for (const SlidingWindow &window: windows) {
+            const bh_view &first = *window.views[0].first;
+            const size_t id = scope.symbols.viewID(first);
+            util::spaces(out, 4 + block.rank * 4);
+            out << writeType(first.base->type);
+            for (int64_t i = 0; i < window.size(); ++i) {
+                out << (i == 0 ? " " : ", ");
+                scope.getWindowName(id, i, out);
+            }
+            out << ";\n";
+            util::spaces(out, 4 + block.rank * 4);
+            out << "{const " << writeType(bh_type::UINT64) << " i" << block.rank << " = 0;";
+            for (int64_t i = 0; i < window.size() - 1; ++i) {
+                out << " ";
+                scope.getWindowName(id, i, out);
+                out << " = ";
+                if (i == 0) {
+                    write_array_access(scope, first, out, true);
+                } else {
+                    write_array_access(scope, first, out, true, BH_MAXDIM,
+                                       std::make_pair(static_cast<int>(block.rank), static_cast<int>(i)));
+                }
+                out << ";";
+            }
+            out << "}\n";
+        }
+    }
+
+    // Writes the load of the last element of the sliding 'windows', which is the element of the foremost view
+    void writeSlidingWindowLoads(const Scope &scope, const LoopB &block, const std::vector<SlidingWindow> &windows,
+                                 std::stringstream &out) {
+        for (const SlidingWindow &window: windows) {
+            util::spaces(out, 8 + block.rank * 4);
+            scope.getWindowName(scope.symbols.viewID(*window.views[0].first), window.size() - 1, out);
+            out << " = ";
+            write_array_access(scope, *window.views.back().first, out);
+            out << ";\n";
+        }
+    }
+
+    // Writes the rotation of the sliding 'windows' at the end of the loop body
+    void writeSlidingWindowRotations(const Scope &scope, const LoopB &block,
+                                     const std::vector<SlidingWindow> &windows, std::stringstream &out) {
+        for (const SlidingWindow &window: windows) {
+            const size_t id = scope.symbols.viewID(*window.views[0].first);
+            util::spaces(out, 8 + block.rank * 4);
+            for (int64_t i = 0; i < window.size() - 1; ++i) {
+                scope.getWindowName(id, i, out);
+                out << " = ";
+                scope.getWindowName(id, i + 1, out);
+                out << (i + 2 < window.size() ? "; " : ";\n");
+            }
+        }
+    }
+
+    // Returns the bit-packed boolean array that 'block' reduces when the block is an innermost loop that only
+    // does any/all reductions of the array or counts its true elements (through casts into temporary arrays).
+    // Such a loop can read the array a word at a time. Returns NULL when the block is not such a loop.
+    static const bh_view *packedReduction(const LoopB &block, const Scope &scope) {
+        if (not block.isInnermost() or block._sweeps.empty()) {
+            return nullptr;
+        }
+        const bh_view *input = nullptr;
+        std::set<bh_view> counted; // The temporary arrays that holds the casts of 'input'
+        for (const InstrPtr &instr: block.getLocalInstr()) {
+            if (bh_opcode_is_system(instr->opcode)) {
+                continue;
+            }
+            const bh_view *in = &instr->operand[1];
+            if (bh_is_constant(in)) {
+                return nullptr;
+            }
+            if (instr->opcode == BH_IDENTITY) {
+                if (not bh_type_is_integer(instr->operand[0].base->type) or not scope.isTmp(instr->operand[0].base)) {
+                    return nullptr;
+                }
+                counted.insert(instr->operand[0]);
+            } else if (instr->opcode == BH_LOGICAL_OR_REDUCE or instr->opcode == BH_LOGICAL_AND_REDUCE or
+                       instr->opcode == BH_ADD_REDUCE) {
+                if (instr->sweep_axis() != block.rank or not sweeping_innermost_axis(instr) or
+                    scope.isArray(instr->operand[0])) {
+                    return nullptr;
+                }
+                if (instr->opcode == BH_ADD_REDUCE) {
+                    if (not util::exist(counted, *in)) {
+                        return nullptr;
+                    }
+                    continue; // The input of the count is the cast, which we have already checked
+                }
+            } else {
+                return nullptr;
+            }
+            if (input == nullptr) {
+                input = in;
+            } else if (not (*input == *in)) {
+                return nullptr;
+            }
+        }
+        // NB: the input might be scalar replaced, which we ignore since we read the array directly
+        if (input == nullptr or scope.isTmp(input->base) or not input->base->packed or
+            input->ndim != block.rank + 1 or input->stride[block.rank] != 1) {
+            return nullptr;
+        }
+        return input;
+    }
+
+    // Writes the reductions of 'block' found by `packedReduction()`. The unaligned bits at both ends of the
+    // reduced axis are read one at a time and the words in between are tested or counted using popcount.
+    void writePackedReduction(const Scope &scope, const LoopB &block, const bh_view &input, std::stringstream &out) {
+        using namespace std;
+        const string rank = std::to_string(block.rank);
+        const string offset = "po" + rank;
+        const string iter = "pk" + rank;
+        const string element = "a" + std::to_string(scope.symbols.baseID(input.base)) + ", " + offset + " + " + iter;
+
+        stringstream init, bit_update, word_update;
+        for (const InstrPtr &instr: block.getLocalInstr()) {
+            if (not bh_opcode_is_sweep(instr->opcode)) {
+                continue;
+            }
+            const string name = scope.getName(instr->operand[0]);
+            if (instr->opcode == BH_LOGICAL_OR_REDUCE) {
+                init << name << " = 0; ";
+                bit_update << name << " = " << name << " || BH_BIT_GET(" << element << "); ";
+                word_update << name << " = " << name << " || BH_BIT_WORD(" << element << ") != 0u; ";
+            } else if (instr->opcode == BH_LOGICAL_AND_REDUCE) {
+                init << name << " = 1; ";
+                bit_update << name << " = " << name << " && BH_BIT_GET(" << element << "); ";
+                word_update << name << " = " << name << " && BH_BIT_WORD(" << element << ") == 0xFFFFFFFFu; ";
+            } else {
+                init << name << " = 0; ";
+                bit_update << name << " += BH_BIT_GET(" << element << "); ";
+                word_update << name << " += BH_POPCOUNT(BH_BIT_WORD(" << element << ")); ";
+            }
+        }
+
+        util::spaces(out, 4 + block.rank * 4);
+        out << "{ // Bit-packed reduction, a word at a time\n";
+        util::spaces(out, 8 + block.rank * 4);
+        out << writeType(bh_type::UINT64) << " i" << rank << " = 0;\n";
+        util::spaces(out, 8 + block.rank * 4);
+        out << "const " << writeType(bh_type::UINT64) << " " << offset << " = ";
+        write_array_element_index(scope, input, out, true);
+        out << ";\n";
+        util::spaces(out, 8 + block.rank * 4);
+        out << writeType(bh_type::UINT64) << " " << iter << " = 0;\n";
+        util::spaces(out, 8 + block.rank * 4);
+        string init_str = init.str();
+        init_str.pop_back(); // Remove the trailing space
+        out << init_str << "\n";
+        util::spaces(out, 8 + block.rank * 4);
+        out << "for(; " << iter << " < " << block.size << " && ((" << offset << " + " << iter << ") & 31) != 0; ++"
+            << iter << ") { " << bit_update.str() << "}\n";
+        util::spaces(out, 8 + block.rank * 4);
+        out << "for(; " << iter << " + 32 <= " << block.size << "; " << iter << " += 32) { " << word_update.str()
+            << "}\n";
+        util::spaces(out, 8 + block.rank * 4);
+        out << "for(; " << iter << " < " << block.size << "; ++" << iter << ") { " << bit_update.str() << "}\n";
+        util::spaces(out, 4 + block.rank * 4);
+        out << "}\n";
+    }
 
-private:
     bool needToPeel(const std::vector<InstrPtr> &ordered_block_sweeps, const Scope &scope) {
         for (const InstrPtr &instr: ordered_block_sweeps) {
             const bh_view &v = instr->operand[0];
@@ -379,6 +672,35 @@ private:
         }
         return indexes;
     }
+
+    // Find the arrays of the inner loops of 'block' that should have their offset in 'block' declared, which
+    // makes the index calculation in the innermost loop the declared offset plus the innermost iterator times
+    // the stride. NB: reduction outputs are ignored since their index skips the reduced axis and so are the views
+    // that peeling creates, which aren't in the symbol table.
+    std::vector<const bh_view*> getOffsets(const LoopB &block, const Scope &scope, const SymbolTable &symbols) {
+        std::vector<const bh_view*> offsets;
+        if (not symbols.offset_as_var) {
+            return offsets;
+        }
+        std::set<bh_view, OffsetAndStrides_less> candidates;
+        for (const Block &b: block._block_list) {
+            if (b.isInstr()) {
+                continue;
+            }
+            for (const InstrPtr &instr: b.getLoop().getAllInstr()) {
+                for (const bh_view *view: instr->get_views()) {
+                    if (bh_opcode_is_reduction(instr->opcode) and view == &instr->operand[0]) {
+                        continue;
+                    }
+                    if (view->ndim > block.rank + 1 and not bh_is_scalar(view) and scope.isArray(*view) and
+                        symbols.existOffsetStridesID(*view) and candidates.insert(*view).second) {
+                        offsets.push_back(view);
+                    }
+                }
+            }
+        }
+        return offsets;
+    }
 };
 
 }} // namespace
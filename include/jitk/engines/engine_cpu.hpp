@@ -27,14 +27,33 @@ If not, see <http://www.gnu.org/licenses/>.
 #include <bh_view.hpp>
 #include <bh_component.hpp>
 #include <bh_instruction.hpp>
+#include <jitk/temporal_blocking.hpp>
 
 namespace bohrium {
 namespace jitk {
 
 class EngineCPU : public Engine {
+protected:
+    // The minimum size in bytes of the arrays that the innermost loops write with non-temporal stores (zero disables)
+    const uint64_t streaming_store_threshold;
+
+    // Returns true when an innermost loop of 'block' writes an output with non-temporal stores
+    bool hasStreamedOutputs(const SymbolTable &symbols, const LoopB &block) const {
+        if (not streamed_outputs(symbols, block, nullptr, streaming_store_threshold).empty()) {
+            return true;
+        }
+        for (const Block &b: block._block_list) {
+            if (not b.isInstr() and hasStreamedOutputs(symbols, b.getLoop())) {
+                return true;
+            }
+        }
+        return false;
+    }
+
 public:
     EngineCPU(const ConfigParser &config, Statistics &stat) :
-      Engine(config, stat) {
+      Engine(config, stat),
+      streaming_store_threshold(get_streaming_store_threshold(config)) {
     }
 
     virtual ~EngineCPU() {}
@@ -42,6 +61,7 @@ public:
     virtual void writeKernel(const std::vector<Block> &block_list,
                              const SymbolTable &symbols,
                              const std::vector<bh_base*> &kernel_temps,
+                             const KernelRepeat &repeat,
                              uint64_t codegen_hash,
                              std::stringstream &ss) = 0;
 
@@ -49,9 +69,28 @@ public:
                          uint64_t codegen_hash,
                          const std::vector<bh_base*> &non_temps,
                          const std::vector<const bh_view*> &offset_strides,
-                         const std::vector<const bh_instruction*> &constants) = 0;
+                         const std::vector<const bh_instruction*> &constants,
+                         const KernelRepeat &repeat) = 0;
+
+    // Returns the buffer index of each kernel temporary (see `kernel_temp_buffers()`)
+    std::vector<size_t> kernelTempBuffers(const std::vector<Block> &block_list,
+                                          const std::vector<bh_base*> &kernel_temps,
+                                          const KernelRepeat &repeat) {
+        // NB: temporal blocking interleaves the blocks thus the temporaries cannot share buffers
+        if (config.defaultGet<bool>("buffer_reuse", true) and repeat.nsteps <= 1) {
+            return kernel_temp_buffers(block_list, kernel_temps);
+        }
+        std::vector<size_t> ret(kernel_temps.size());
+        for (size_t i = 0; i < ret.size(); ++i) {
+            ret[i] = i;
+        }
+        return ret;
+    }
 
-    virtual void handleExecution(BhIR *bhir) {
+    // Execute the instructions in 'bhir'. When 'repeat_in_kernel' is true, all the repeats of 'bhir'
+    // (see `BhIR::_nrepeats`) are executed by one monolithic kernel call.
+    // NB: the caller must make sure that 'bhir' contains no extension methods
+    virtual void handleExecution(BhIR *bhir, bool repeat_in_kernel = false) {
         using namespace std;
 
         const auto texecution = chrono::steady_clock::now();
@@ -59,6 +98,9 @@ public:
         map<string, bool> kernel_config = {
             { "strides_as_var", config.defaultGet<bool>("strides_as_var", true) },
             { "index_as_var",   config.defaultGet<bool>("index_as_var",   true) },
+            { "offset_as_var",  config.defaultGet<bool>("offset_as_var",  false) },
+            { "sliding_window", config.defaultGet<bool>("sliding_window", false) },
+            { "hoist_broadcast", config.defaultGet<bool>("hoist_broadcast", false) },
             { "const_as_var",   config.defaultGet<bool>("const_as_var",   true) },
             { "use_volatile",   config.defaultGet<bool>("use_volatile",  false) }
         };
@@ -89,11 +131,27 @@ public:
         // Let's get the block list
         const vector<jitk::Block> block_list = get_block_list(instr_list, config, fcache, stat, false);
 
-        if (config.defaultGet<bool>("monolithic", false)) {
-            createMonolithicKernel(kernel_config, block_list);
+        // The arrays that leave the engine are never bit-packed
+        _unpacked_bases = bhir->getSyncs();
+        if (bhir->getRepeatCondition() != nullptr) {
+            _unpacked_bases.insert(bhir->getRepeatCondition());
+        }
+
+        if (repeat_in_kernel) {
+            KernelRepeat repeat;
+            repeat.nrepeats = bhir->getNRepeats();
+            repeat.condition = bhir->getRepeatCondition();
+            createMonolithicKernel(kernel_config, block_list, repeat);
+        } else if (config.defaultGet<bool>("monolithic", false)) {
+            createMonolithicKernel(kernel_config, block_list, KernelRepeat());
         } else {
             createKernel(kernel_config, block_list);
         }
+
+        // The bit-packed storage is private to the kernels thus we unpack the arrays that leave the engine
+        for (bh_base *base: _unpacked_bases) {
+            bh_data_unpack(base);
+        }
         stat.time_total_execution += chrono::steady_clock::now() - texecution;
     }
 
@@ -108,6 +166,9 @@ public:
                 BhIR b(std::move(instr_list), bhir->getSyncs());
                 comp.execute(&b);
                 instr_list.clear(); // Notice, it is legal to clear a moved vector.
+                for (bh_base *base: instr.get_bases()) {
+                    bh_data_unpack(base);
+                }
                 const auto texecution = std::chrono::steady_clock::now();
                 ext->second.execute(&instr, nullptr); // Execute the extension method
                 stat.time_ext_method += std::chrono::steady_clock::now() - texecution;
@@ -134,6 +195,9 @@ private:
                 kernel_config["use_volatile"],
                 kernel_config["strides_as_var"],
                 kernel_config["index_as_var"],
+                kernel_config["offset_as_var"],
+                kernel_config["sliding_window"],
+                kernel_config["hoist_broadcast"],
                 kernel_config["const_as_var"]
             );
 
@@ -141,7 +205,7 @@ private:
 
             // Let's execute the kernel
             if (not block.isSystemOnly()) { // We can skip this step if the kernel does no computation
-                executeKernel({ block }, symbols, {});
+                executeKernel({ block }, symbols, {}, KernelRepeat());
             }
 
             // Finally, let's cleanup
@@ -151,7 +215,8 @@ private:
         }
     }
 
-    void createMonolithicKernel(std::map<std::string, bool> kernel_config, const std::vector<Block> &block_list) {
+    void createMonolithicKernel(std::map<std::string, bool> kernel_config, const std::vector<Block> &block_list,
+                                KernelRepeat repeat) {
         using namespace std;
 
         // When creating a monolithic kernel (all instructions in one shared library), we first combine
@@ -187,13 +252,53 @@ private:
             kernel_config["use_volatile"],
             kernel_config["strides_as_var"],
             kernel_config["index_as_var"],
+            kernel_config["offset_as_var"],
+            kernel_config["sliding_window"],
+            kernel_config["hoist_broadcast"],
             kernel_config["const_as_var"]
         );
         stat.record(symbols);
 
+        // If the kernel never touches the repeat condition, the condition cannot change between repeats
+        if (repeat.condition != nullptr and not util::exist(all_non_temps, repeat.condition)) {
+            if (repeat.condition->data != nullptr and not static_cast<bool*>(repeat.condition->data)[0]) {
+                repeat.nrepeats = 1;
+            }
+            repeat.condition = nullptr;
+        }
+
+        // Temporal blocking requires that all repeats run thus it cannot be used with a repeat condition
+        const uint64_t nsteps = config.defaultGet<uint64_t>("temporal_blocking", 1);
+        if (repeat.enabled() and repeat.condition == nullptr and nsteps > 1 and nsteps <= repeat.nrepeats) {
+            repeat.shifts = temporal_blocking_shifts(block_list, nsteps);
+            if (not repeat.shifts.empty()) {
+                repeat.nsteps = nsteps;
+            }
+        }
+
+        // Some statistics of the memory used by the kernel temporaries
+        if (stat.enabled and kernel_is_computing) {
+            const vector<size_t> buffers = kernelTempBuffers(block_list, kernel_temps, repeat);
+            map<size_t, uint64_t> buffer_bytes;
+            uint64_t temp_bytes = 0;
+            for (size_t i = 0; i < kernel_temps.size(); ++i) {
+                temp_bytes += bh_base_size(kernel_temps[i]);
+                buffer_bytes[buffers[i]] = bh_base_size(kernel_temps[i]);
+            }
+            uint64_t total_buffer_bytes = 0;
+            for (const auto &buffer: buffer_bytes) {
+                total_buffer_bytes += buffer.second;
+            }
+            stat.max_kernel_temp_bytes = std::max(stat.max_kernel_temp_bytes, temp_bytes);
+            stat.max_kernel_buffer_bytes = std::max(stat.max_kernel_buffer_bytes, total_buffer_bytes);
+        }
+
         // Let's execute the kernel
         if (kernel_is_computing) { // We can skip this step if the kernel does no computation
-            executeKernel(block_list, symbols, kernel_temps);
+            executeKernel(block_list, symbols, kernel_temps, repeat);
+            if (repeat.enabled()) {
+                ++stat.num_repeat_kernels;
+            }
         }
 
         // Finally, let's cleanup
@@ -202,11 +307,77 @@ private:
         }
     }
 private:
+    // The arrays that must not be bit-packed, which are the synced arrays and the repeat condition of the BhIR
+    std::set<bh_base*> _unpacked_bases;
+
+    // Can 'instr' write its output to a bit-packed array? The write of a bit is a read-modify-write of its word,
+    // which only works for element-wise instructions that do not read the output array.
+    static bool packedWriteCompatible(const bh_instruction &instr) {
+        if (bh_opcode_is_reduction(instr.opcode) or bh_opcode_is_accumulate(instr.opcode) or
+            instr.opcode == BH_SCATTER or instr.opcode == BH_COND_SCATTER) {
+            return false;
+        }
+        for (size_t o = 1; o < instr.operand.size(); ++o) {
+            if (not bh_is_constant(&instr.operand[o]) and instr.operand[o].base == instr.operand[0].base) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Decide the storage of the boolean arrays of the kernel. When `packed_bool` is enabled, unallocated boolean
+    // arrays are bit-packed if all their writes are compatible. Packed arrays with incompatible writes are unpacked.
+    void updatePackedStorage(const std::vector<Block> &block_list, const SymbolTable &symbols) {
+        const bool packed_bool = config.defaultGet<bool>("packed_bool", false);
+        std::map<bh_base*, bool> compatible; // The boolean arrays written by the kernel
+        for (const Block &block: block_list) {
+            for (const InstrPtr &instr: block.getAllInstr()) {
+                if (bh_opcode_is_system(instr->opcode) or instr->operand.empty()) {
+                    continue;
+                }
+                bh_base *base = instr->operand[0].base;
+                if (base->type == bh_type::BOOL) {
+                    auto it = compatible.insert(std::make_pair(base, true)).first;
+                    it->second = it->second and packedWriteCompatible(*instr) and not symbols.isAlwaysArray(base);
+                }
+            }
+        }
+        for (bh_base *base: symbols.getParams()) {
+            auto it = compatible.find(base);
+            if (it == compatible.end()) {
+                continue; // Reading a packed array is always possible
+            }
+            if (base->packed and not it->second) {
+                bh_data_unpack(base);
+            } else if (packed_bool and it->second and base->data == nullptr and
+                       not util::exist(_unpacked_bases, base)) {
+                base->packed = true;
+            }
+        }
+    }
+
+    // Hashes the outputs that the innermost loops of 'block' write with non-temporal stores into 'seed'
+    uint64_t hashStreamedOutputs(const SymbolTable &symbols, const Block &block, uint64_t seed) const {
+        if (block.isInstr()) {
+            return seed;
+        }
+        for (const bh_view *view: streamed_outputs(symbols, block.getLoop(), nullptr, streaming_store_threshold)) {
+            seed = util::hash("streamed" + std::to_string(symbols.baseID(view->base)), seed);
+        }
+        for (const Block &b: block.getLoop()._block_list) {
+            seed = hashStreamedOutputs(symbols, b, seed);
+        }
+        return seed;
+    }
+
     void executeKernel(const std::vector<Block> &block_list,
                        const SymbolTable &symbols,
-                       std::vector<bh_base*> kernel_temps) {
+                       std::vector<bh_base*> kernel_temps,
+                       const KernelRepeat &repeat) {
         using namespace std;
 
+        updatePackedStorage(block_list, symbols);
+
         // Create the constant vector
         vector<const bh_instruction*> constants;
         constants.reserve(symbols.constIDs().size());
@@ -214,28 +385,51 @@ private:
             constants.push_back(&(*instr));
         }
 
-        const auto lookup = codegen_cache.get(block_list, symbols);
+        // Kernels with a repeat loop are written differently thus they need their own cache entries
+        uint64_t seed = 0;
+        if (repeat.enabled()) {
+            seed = repeat.condition == nullptr ? 1 : 2 + symbols.baseID(repeat.condition);
+            // NB: the shifts depend on the view offsets, which might not be part of the codegen hash
+            for (int64_t shift: repeat.shifts) {
+                seed = util::hash(std::to_string(shift), seed);
+            }
+        }
+        // NB: the storage of the boolean arrays is not part of the codegen hash
+        for (const bh_base *base: symbols.getParams()) {
+            if (base->packed) {
+                seed = util::hash("packed" + std::to_string(symbols.baseID(base)), seed);
+            }
+        }
+
+        // NB: the non-temporal stores depend on the array sizes, which might not be part of the codegen hash
+        if (streaming_store_threshold > 0) {
+            for (const Block &block: block_list) {
+                seed = hashStreamedOutputs(symbols, block, seed);
+            }
+        }
+
+        const auto lookup = codegen_cache.get(block_list, symbols, seed);
         if(not lookup.first.empty()) {
             // In debug mode, we check that the cached source code is correct
             #ifndef NDEBUG
                 stringstream ss;
-                writeKernel(block_list, symbols, kernel_temps, lookup.second, ss);
+                writeKernel(block_list, symbols, kernel_temps, repeat, lookup.second, ss);
                 if (ss.str().compare(lookup.first) != 0) {
                     cout << "\nCached source code: \n" << lookup.first;
                     cout << "\nReal source code: \n" << ss.str();
                     assert(1 == 2);
                 }
             #endif
-            execute(lookup.first, lookup.second, symbols.getParams(), symbols.offsetStrideViews(), constants);
+            execute(lookup.first, lookup.second, symbols.getParams(), symbols.offsetStrideViews(), constants, repeat);
         } else {
             const auto tcodegen = chrono::steady_clock::now();
             stringstream ss;
-            writeKernel(block_list, symbols, kernel_temps, lookup.second, ss);
+            writeKernel(block_list, symbols, kernel_temps, repeat, lookup.second, ss);
             string source = ss.str();
             stat.time_codegen += chrono::steady_clock::now() - tcodegen;
 
-            execute(source, lookup.second, symbols.getParams(), symbols.offsetStrideViews(), constants);
-            codegen_cache.insert(std::move(source), block_list, symbols);
+            execute(source, lookup.second, symbols.getParams(), symbols.offsetStrideViews(), constants, repeat);
+            codegen_cache.insert(std::move(source), block_list, symbols, seed);
         }
     }
 };
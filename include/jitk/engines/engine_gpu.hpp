@@ -83,6 +83,9 @@ public:
         map<string, bool> kernel_config = {
             { "strides_as_var", config.defaultGet<bool>("strides_as_var", true) },
             { "index_as_var",   config.defaultGet<bool>("index_as_var",   true) },
+            { "offset_as_var",  config.defaultGet<bool>("offset_as_var",  false) },
+            { "sliding_window", config.defaultGet<bool>("sliding_window", false) },
+            { "hoist_broadcast", config.defaultGet<bool>("hoist_broadcast", false) },
             { "const_as_var",   config.defaultGet<bool>("const_as_var",   true) },
             { "use_volatile",   config.defaultGet<bool>("use_volatile",  false) }
         };
@@ -125,6 +128,9 @@ public:
               kernel_config["use_volatile"],
               kernel_config["strides_as_var"],
               kernel_config["index_as_var"],
+              kernel_config["offset_as_var"],
+              kernel_config["sliding_window"],
+              kernel_config["hoist_broadcast"],
               kernel_config["const_as_var"]
             );
             stat.record(symbols);
@@ -252,7 +258,11 @@ private:
     {
         using namespace std;
         // We need a memory buffer on the device for each non-temporary array in the kernel
+        // NB: the bit-packed storage of the CPU engine is not used on the device
         const vector<bh_base*> v = symbols.getParams();
+        for (bh_base *base: v) {
+            bh_data_unpack(base);
+        }
         copyToDevice(set<bh_base*>(v.begin(), v.end()));
 
         // Create the constant vector
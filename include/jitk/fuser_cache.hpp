@@ -30,6 +30,10 @@ If not, see <http://www.gnu.org/licenses/>.
 namespace bohrium {
 namespace jitk {
 
+// Returns the structural hash of 'instr_list', which identifies the views by the order of their first
+// appearance and ignores the values of the constants. NB: this is the hash the fuse cache uses as key.
+size_t hash_instr_list(const std::vector<bh_instruction *> &instr_list);
+
 class FuseCache {
 private:
     std::map<size_t, std::vector<Block> > _cache;
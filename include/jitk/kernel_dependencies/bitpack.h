@@ -0,0 +1,50 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+// Access to boolean arrays that are bit-packed into 32-bit words, i.e. element 'i' is bit 'i % 32' of word 'i / 32'.
+// Neighboring elements share a word thus the writes are atomic. Works in C99, OpenCL, and CUDA.
+
+#if defined(__OPENCL_VERSION__)
+    #define BH_BIT_WORDS(a) ((__global unsigned int *) (a))
+    #define BH_BIT_OR(p, m) atomic_or((volatile __global unsigned int *) (p), (m))
+    #define BH_BIT_AND(p, m) atomic_and((volatile __global unsigned int *) (p), (m))
+    #define BH_POPCOUNT(w) popcount(w)
+#elif defined(__CUDACC__)
+    #define BH_BIT_WORDS(a) ((unsigned int *) (a))
+    #define BH_BIT_OR(p, m) atomicOr((p), (m))
+    #define BH_BIT_AND(p, m) atomicAnd((p), (m))
+    #define BH_POPCOUNT(w) __popc(w)
+#else
+    #define BH_BIT_WORDS(a) ((unsigned int *) (a))
+    #define BH_BIT_OR(p, m) __atomic_fetch_or((p), (m), __ATOMIC_RELAXED)
+    #define BH_BIT_AND(p, m) __atomic_fetch_and((p), (m), __ATOMIC_RELAXED)
+    #define BH_POPCOUNT(w) __builtin_popcount(w)
+#endif
+
+// The word that holds element 'i'
+#define BH_BIT_WORD(a, i) (BH_BIT_WORDS(a)[(i) >> 5])
+
+// Read element 'i'
+#define BH_BIT_GET(a, i) ((bool) ((BH_BIT_WORD(a, i) >> ((i) & 31)) & 1u))
+
+// Write 'v' to element 'i'
+#define BH_BIT_SET(a, i, v) ((v) ? BH_BIT_OR(&BH_BIT_WORD(a, i), 1u << ((i) & 31)) \
+                                 : BH_BIT_AND(&BH_BIT_WORD(a, i), ~(1u << ((i) & 31))))
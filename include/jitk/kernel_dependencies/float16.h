@@ -0,0 +1,81 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+// Conversion between the 16-bit float types, which the kernels store as their bit pattern, and single
+// precision. The arithmetic is always done in single precision. Works in C99, OpenCL, and CUDA.
+
+#if defined(__OPENCL_VERSION__)
+    #define BH_HALF_FUNC inline
+    #define BH_FLOAT_BITS(f) as_uint(f)
+    #define BH_BITS_FLOAT(u) as_float(u)
+#elif defined(__CUDACC__)
+    #define BH_HALF_FUNC __device__ static inline
+    #define BH_FLOAT_BITS(f) ((unsigned int) __float_as_int(f))
+    #define BH_BITS_FLOAT(u) __int_as_float((int) (u))
+#else
+    #define BH_HALF_FUNC static inline
+    static inline unsigned int bh_float_bits(float f) { union {float f; unsigned int u;} t; t.f = f; return t.u; }
+    static inline float bh_bits_float(unsigned int u) { union {float f; unsigned int u;} t; t.u = u; return t.f; }
+    #define BH_FLOAT_BITS(f) bh_float_bits(f)
+    #define BH_BITS_FLOAT(u) bh_bits_float(u)
+#endif
+
+BH_HALF_FUNC float bh_float16_to_float32(unsigned short h) {
+    const unsigned int sign = ((unsigned int) h & 0x8000u) << 16;
+    const unsigned int exp = ((unsigned int) h >> 10) & 0x1Fu;
+    const unsigned int mant = (unsigned int) h & 0x3FFu;
+    if (exp == 0x1Fu) { // Inf or NaN
+        return BH_BITS_FLOAT(sign | 0x7F800000u | (mant << 13));
+    }
+    if (exp == 0) { // Zero or subnormal, which is exactly mant * 2^-24
+        const float ret = (float) mant * 5.9604644775390625e-08f;
+        return sign ? -ret : ret;
+    }
+    return BH_BITS_FLOAT(sign | ((exp + 112u) << 23) | (mant << 13));
+}
+
+BH_HALF_FUNC unsigned short bh_float32_to_float16(float f) {
+    const unsigned int bits = BH_FLOAT_BITS(f);
+    const unsigned int sign = (bits >> 16) & 0x8000u;
+    const unsigned int a = bits & 0x7FFFFFFFu;
+    if (a >= 0x7F800000u) { // Inf or NaN, where NaN stays a quiet NaN
+        return (unsigned short) (sign | 0x7C00u | (a > 0x7F800000u ? 0x200u : 0u));
+    }
+    if (a >= 0x477FF000u) { // Rounds to a magnitude above 65504
+        return (unsigned short) (sign | 0x7C00u);
+    }
+    if (a < 0x38800000u) { // Subnormal or zero, rounded to nearest even by the float addition
+        return (unsigned short) (sign | (BH_FLOAT_BITS(BH_BITS_FLOAT(a) + 0.5f) - 0x3F000000u));
+    }
+    return (unsigned short) (sign | ((a - 0x38000000u + 0xFFFu + ((a >> 13) & 1u)) >> 13));
+}
+
+BH_HALF_FUNC float bh_bfloat16_to_float32(unsigned short h) {
+    return BH_BITS_FLOAT((unsigned int) h << 16);
+}
+
+BH_HALF_FUNC unsigned short bh_float32_to_bfloat16(float f) {
+    const unsigned int bits = BH_FLOAT_BITS(f);
+    if ((bits & 0x7FFFFFFFu) > 0x7F800000u) { // NaN stays a quiet NaN
+        return (unsigned short) ((bits >> 16) | 0x40u);
+    }
+    return (unsigned short) ((bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16);
+}
@@ -35,3 +35,26 @@ __inline__ __device__ uint64_t random123(uint64_t start, uint64_t key, uint64_t
 
     return *((uint64_t*)&result);
 }
+
+// Uniform doubles in [0, 1) made from the 53 most significant bits
+__inline__ __device__ double random123_uniform_float64(uint64_t start, uint64_t key, uint64_t index) {
+    return (random123(start, key, index) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Uniform floats in [0, 1) made from the 24 most significant bits
+__inline__ __device__ float random123_uniform_float32(uint64_t start, uint64_t key, uint64_t index) {
+    return (random123(start, key, index) >> 40) * (1.0f / 16777216.0f);
+}
+
+// Standard normals by the Box-Muller transform of the two uniforms of the counters `2*index` and `2*index+1`
+__inline__ __device__ double random123_normal_float64(uint64_t start, uint64_t key, uint64_t index) {
+    const double u1 = 1.0 - random123_uniform_float64(start, key, 2 * index); // In (0, 1]
+    const double u2 = random123_uniform_float64(start, key, 2 * index + 1);
+    return sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+}
+
+__inline__ __device__ float random123_normal_float32(uint64_t start, uint64_t key, uint64_t index) {
+    const float u1 = 1.0f - random123_uniform_float32(start, key, 2 * index); // In (0, 1]
+    const float u2 = random123_uniform_float32(start, key, 2 * index + 1);
+    return sqrtf(-2.0f * logf(u1)) * cosf(6.2831853f * u2);
+}
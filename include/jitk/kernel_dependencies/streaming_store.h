@@ -0,0 +1,64 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+// Non-temporal (streaming) stores, which write whole cache lines to memory without reading them into the cache first.
+// The kernels compute a strip of elements into a local buffer and then stream the buffer to the output array.
+// NB: the stores are weakly ordered, thus the kernels call bh_stream_fence() after the outermost loop, in each thread
+//     of a parallel loop before its barrier (or before the synchronization of the thread pool).
+
+#include <stdint.h>
+#include <string.h>
+#if defined(__AVX__)
+    #include <immintrin.h>
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+// Copy 'nbytes' of the buffer 'src' of 'capacity' bytes to 'dst'. Only a full buffer is streamed, which makes the
+// number of stores a compile-time constant. A partial buffer, or a misaligned 'dst', is copied normally.
+static inline void bh_stream_store(void *dst, const void *src, uint64_t capacity, uint64_t nbytes) {
+    char *d = (char *) dst;
+    const char *s = (const char *) src;
+#if defined(__AVX__)
+    if (nbytes == capacity && capacity % 32 == 0 && ((uintptr_t) d & 31) == 0) {
+        for (uint64_t i = 0; i < capacity; i += 32) {
+            _mm256_stream_si256((__m256i *) (d + i), _mm256_loadu_si256((const __m256i *) (s + i)));
+        }
+        return;
+    }
+#endif
+#if defined(__SSE2__)
+    if (nbytes == capacity && capacity % 16 == 0 && ((uintptr_t) d & 15) == 0) {
+        for (uint64_t i = 0; i < capacity; i += 16) {
+            _mm_stream_si128((__m128i *) (d + i), _mm_loadu_si128((const __m128i *) (s + i)));
+        }
+        return;
+    }
+#endif
+    memcpy(d, s, nbytes);
+}
+
+// Order the preceding non-temporal stores of this thread before its following stores
+static inline void bh_stream_fence(void) {
+#if defined(__SSE2__)
+    _mm_sfence();
+#endif
+}
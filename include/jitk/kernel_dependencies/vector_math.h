@@ -0,0 +1,77 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+// Declares the SIMD variants of the math functions that glibc's libmvec implements, which makes GCC vectorize the
+// loops that call them. The variants are within 4 ulp of the correctly rounded result.
+// NB: the function names are in parentheses since <tgmath.h> defines them as macros. With -ffast-math, glibc's
+//     <math.h> declares the variants itself.
+
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__GLIBC__) && !defined(__FAST_MATH__)
+#define BH_DECL_SIMD __attribute__((__simd__("notinbranch")))
+
+BH_DECL_SIMD double (exp)(double);
+BH_DECL_SIMD float (expf)(float);
+BH_DECL_SIMD double (log)(double);
+BH_DECL_SIMD float (logf)(float);
+BH_DECL_SIMD double (sin)(double);
+BH_DECL_SIMD float (sinf)(float);
+BH_DECL_SIMD double (cos)(double);
+BH_DECL_SIMD float (cosf)(float);
+BH_DECL_SIMD double (pow)(double, double);
+BH_DECL_SIMD float (powf)(float, float);
+
+#if __GLIBC_PREREQ(2, 35) // The rest of the variants came with glibc 2.35
+BH_DECL_SIMD double (exp2)(double);
+BH_DECL_SIMD float (exp2f)(float);
+BH_DECL_SIMD double (expm1)(double);
+BH_DECL_SIMD float (expm1f)(float);
+BH_DECL_SIMD double (log2)(double);
+BH_DECL_SIMD float (log2f)(float);
+BH_DECL_SIMD double (log10)(double);
+BH_DECL_SIMD float (log10f)(float);
+BH_DECL_SIMD double (log1p)(double);
+BH_DECL_SIMD float (log1pf)(float);
+BH_DECL_SIMD double (tan)(double);
+BH_DECL_SIMD float (tanf)(float);
+BH_DECL_SIMD double (asin)(double);
+BH_DECL_SIMD float (asinf)(float);
+BH_DECL_SIMD double (acos)(double);
+BH_DECL_SIMD float (acosf)(float);
+BH_DECL_SIMD double (atan)(double);
+BH_DECL_SIMD float (atanf)(float);
+BH_DECL_SIMD double (atan2)(double, double);
+BH_DECL_SIMD float (atan2f)(float, float);
+BH_DECL_SIMD double (sinh)(double);
+BH_DECL_SIMD float (sinhf)(float);
+BH_DECL_SIMD double (cosh)(double);
+BH_DECL_SIMD float (coshf)(float);
+BH_DECL_SIMD double (tanh)(double);
+BH_DECL_SIMD float (tanhf)(float);
+BH_DECL_SIMD double (asinh)(double);
+BH_DECL_SIMD float (asinhf)(float);
+BH_DECL_SIMD double (acosh)(double);
+BH_DECL_SIMD float (acoshf)(float);
+BH_DECL_SIMD double (atanh)(double);
+BH_DECL_SIMD float (atanhf)(float);
+#endif
+
+#undef BH_DECL_SIMD
+#endif
@@ -0,0 +1,40 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+/* Loop-invariant code motion of repeated BhIRs (see `BhIR::_nrepeats`) */
+
+#include <vector>
+
+#include <bh_ir.hpp>
+#include <bh_instruction.hpp>
+
+namespace bohrium {
+namespace jitk {
+
+// Moves the instructions of 'bhir' that compute the same result in every repeat into 'prologue',
+// which must execute once before 'bhir'. The frees of the arrays that the prologue writes are moved into
+// 'epilogue', which must execute once after 'bhir'.
+// Returns the number of element operations removed from each repeat.
+uint64_t hoist_loop_invariants(BhIR &bhir, std::vector<bh_instruction> &prologue,
+                               std::vector<bh_instruction> &epilogue);
+
+} // jitk
+} // bohrium
@@ -83,6 +83,11 @@ class Statistics {
     uint64_t kernel_cache_misses       = 0;
     uint64_t num_instrs_into_fuser     = 0;
     uint64_t num_blocks_out_of_fuser   = 0;
+    uint64_t num_repeat_kernels        = 0;
+    uint64_t num_hoisted_instrs        = 0;
+    uint64_t hoisted_work              = 0;
+    uint64_t max_kernel_temp_bytes     = 0;
+    uint64_t max_kernel_buffer_bytes   = 0;
     std::chrono::duration<double> time_total_execution{0};
     std::chrono::duration<double> time_pre_fusion{0};
     std::chrono::duration<double> time_fusion{0};
@@ -131,6 +136,11 @@ class Statistics {
             out << "\n";
             out << "Max memory usage:                " << GRN << memoryUsage() << " MB"              << "\n" << RST;
             out << "Syncs to NumPy:                  " << GRN << num_syncs                           << "\n" << RST;
+            out << "Repeat-loop kernel calls:        " << GRN << num_repeat_kernels                  << "\n" << RST;
+            out << "Loop-invariant hoisting:         " << GRN << num_hoisted_instrs << " instructions, "
+                << "saves up to " << hoisted_work << " operations"                                   << "\n" << RST;
+            out << "Kernel temporaries peak:         " << GRN << max_kernel_temp_bytes << " bytes, "
+                << max_kernel_buffer_bytes << " bytes with buffer reuse"                             << "\n" << RST;
             out << "Total Work:                      " << GRN << totalwork << " operations"          << "\n" << RST;
             out << "Throughput:                      " << GRN << throughput() << "ops"               << "\n" << RST;
             out << "Work below par-threshold (1000): " << GRN << workBelowThredshold() << "%"        << "\n" << RST;
@@ -202,6 +212,11 @@ class Statistics {
             file << "  outer_fusion_ratio: "    << outerFusionRatio()                << "\n";
             file << "  memory_usage: "          << memoryUsage()                     << "\n"; // mb
             file << "  syncs: "                 << num_syncs                         << "\n";
+            file << "  repeat_kernels: "        << num_repeat_kernels                << "\n";
+            file << "  hoisted_instrs: "        << num_hoisted_instrs                << "\n";
+            file << "  hoisted_work: "          << hoisted_work                      << "\n"; // ops
+            file << "  kernel_temp_bytes: "     << max_kernel_temp_bytes             << "\n";
+            file << "  kernel_buffer_bytes: "   << max_kernel_buffer_bytes           << "\n";
             file << "  total_work: "            << totalwork                         << "\n"; // ops
             file << "  throughput: "            << throughput()                      << "\n"; // ops
             file << "  work_below_thredshold: " << workBelowThredshold()             << "\n"; // %
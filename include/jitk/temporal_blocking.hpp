@@ -0,0 +1,44 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+/* Temporal blocking of repeated block lists such as stencil time loops.
+ *
+ * The 'nsteps' repeats of a block list of data-parallel loops over the same outermost axis are fused
+ * into one wavefront sweep over that axis. Each loop instance 'q' (the j'th block in the t'th repeat
+ * is 'q = t*nblocks + j') executes row 'p - shift[q]' when the wavefront is at row 'p'.
+ * The shifts are derived from the row offsets of the views (their 'start' and outermost 'stride')
+ * such that every dependency between the loop instances is preserved.
+ */
+
+#include <vector>
+
+#include <jitk/block.hpp>
+
+namespace bohrium {
+namespace jitk {
+
+// Returns the wavefront shift of each loop instance when fusing 'nsteps' repeats of 'block_list' or
+// an empty vector when 'block_list' cannot be temporal blocked.
+// NB: system-only blocks get the shift -1 since they should be ignored
+std::vector<int64_t> temporal_blocking_shifts(const std::vector<Block> &block_list, uint64_t nsteps);
+
+} // jitk
+} // bohrium
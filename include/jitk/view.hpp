@@ -29,6 +29,10 @@ If not, see <http://www.gnu.org/licenses/>.
 namespace bohrium {
 namespace jitk {
 
+// Write the offset of 'view' through the axes [0, 'rank'], e.g. vo2_i0 +i1*10, which builds on the innermost
+// declared offset of 'view' (see `Scope::writeOffsetDeclaration()`)
+void write_array_offset(const Scope &scope, const bh_view &view, int rank, std::stringstream &out);
+
 // Write the array index, e.g. (2+i0*1+i1*10), but ignore the loop-variant of 'hidden_axis' if it isn't 'BH_MAXDIM'
 // Use 'axis_offset' to offset an axis, which is needed for accumulate
 void write_array_index(const Scope &scope, const bh_view &view, std::stringstream &out, int hidden_axis = BH_MAXDIM,
@@ -42,5 +46,17 @@ void write_array_subscription(const Scope &scope, const bh_view &view, std::stri
                               bool ignore_declared_indexes = false, int hidden_axis = BH_MAXDIM,
                               const std::pair<int, int> axis_offset = std::make_pair(BH_MAXDIM, 0));
 
+// Write the read access of an array element, e.g. a2[i0], or BH_BIT_GET(a2, i0) when the array is bit-packed
+void write_array_access(const Scope &scope, const bh_view &view, std::stringstream &out,
+                        bool ignore_declared_indexes = false, int hidden_axis = BH_MAXDIM,
+                        const std::pair<int, int> axis_offset = std::make_pair(BH_MAXDIM, 0));
+
+// Write the read access of 'view' in the loop of 'rank' when the inner loops don't change the element, e.g. a2[vo2_i0]
+void write_hoisted_array_access(const Scope &scope, const bh_view &view, int rank, std::stringstream &out);
+
+// Write the index of the array element, which is the array subscription without the brackets
+void write_array_element_index(const Scope &scope, const bh_view &view, std::stringstream &out,
+                               bool ignore_declared_indexes = false);
+
 } // jitk
 } // bohrium
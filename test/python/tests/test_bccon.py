@@ -0,0 +1,164 @@
+bh_rewrites_src = """
+def rewrites(name, expect, src):
+    env = {"np": np, "bh": bh, "a": a}
+    bh.flush()
+    bh.backend_messaging.statistic_enable_and_reset()
+    exec(src, env)
+    bh.flush()
+    n = int(bh.backend_messaging.statistic().split(name + ":")[1].split()[0])
+    return np.append(env["r"].copy2numpy(), n > 0)
+"""
+
+np_rewrites_src = """
+def rewrites(name, expect, src):
+    env = {"np": np, "bh": bh, "a": a}
+    exec(src, env)
+    return np.append(env["r"], expect)
+"""
+
+
+def rewrites(cmd, name, expect, src):
+    """ Returns the commands that run `src`, which must assign its result to `r`, and checks whether the bccon
+        contraction `name` rewrote any instructions. NumPy doesn't rewrite, thus it gets the `expect`ed answer. """
+    call = "res = rewrites(%r, %d, %r)" % (name, expect, src)
+    return (np_rewrites_src + cmd + call, bh_rewrites_src + cmd + call)
+
+
+class test_cse:
+    """ Common subexpression elimination must reuse identical computations unless their inputs change """
+    def init(self):
+        for dtype in ["np.float32", "np.float64"]:
+            yield "R = bh.random.RandomState(42); a = R.random((10, 10), dtype=%s, bohrium=BH); " % dtype
+
+    def test_reuse(self, cmd):
+        return rewrites(cmd, "Common subexpressions", True, "r = M.sin(a) + M.sin(a)")
+
+    def test_shifted_views(self, cmd):
+        return rewrites(cmd, "Common subexpressions", False, "r = M.sin(a[1:]) + M.sin(a[:-1])")
+
+    def test_written_between(self, cmd):
+        return rewrites(cmd, "Common subexpressions", False, "b = M.sin(a); a += 1; r = b + M.sin(a)")
+
+    def test_extmethod(self, cmd):
+        src = "b = (a * 10).astype(M.int64); r = M.matmul(b, b) + M.matmul(b, b)"
+        return rewrites(cmd, "Common subexpressions", False, src)
+
+
+class test_dead:
+    """ Dead computation elimination must remove the instructions whose results are never read """
+    def init(self):
+        for dtype in ["np.float32", "np.float64"]:
+            yield "R = bh.random.RandomState(42); a = R.random((10, 10), dtype=%s, bohrium=BH); " % dtype
+
+    def test_freed(self, cmd):
+        return rewrites(cmd, "Dead computations", True, "b = M.sin(a); del b; r = M.cos(a)")
+
+    def test_overwritten(self, cmd):
+        return rewrites(cmd, "Dead computations", True, "r = M.sin(a); r[...] = M.cos(a)")
+
+    def test_partially_overwritten(self, cmd):
+        return rewrites(cmd, "Dead computations", False, "r = M.sin(a); r[1:] = M.cos(a[1:])")
+
+    def test_read_through_other_view(self, cmd):
+        return rewrites(cmd, "Dead computations", False, "r = M.sin(a); b = r[::-1] * 2; r[...] = b")
+
+    def test_extmethod(self, cmd):
+        src = "c = (a * 10).astype(M.int64); b = M.matmul(c, c); del b; r = a + 1"
+        return rewrites(cmd, "Dead computations", False, src)
+
+
+class test_copy:
+    """ Copy elimination must read the source of a copy into a temporary array instead of the copy """
+    def init(self):
+        for dtype in ["np.float32", "np.float64"]:
+            yield "R = bh.random.RandomState(42); a = R.random((10, 10), dtype=%s, bohrium=BH); " % dtype
+
+    def test_forward(self, cmd):
+        return rewrites(cmd, "Copy eliminations", True, "b = a.copy(); r = b * 2; del b")
+
+    def test_source_written(self, cmd):
+        return rewrites(cmd, "Copy eliminations", False, "b = a.copy(); a += 1; r = b * 2; del b")
+
+    def test_overlapping_views(self, cmd):
+        return rewrites(cmd, "Copy eliminations", False, "b = a.copy(); r = b[1:] + b[:-1]; del b")
+
+    def test_extmethod(self, cmd):
+        src = "c = (a * 10).astype(M.int64); b = c.copy(); r = M.matmul(b, b); del b"
+        return rewrites(cmd, "Copy eliminations", False, src)
+
+
+class test_algebra:
+    """ The default rewrite rules of the algebraic simplification must not change any value including -0.0, inf,
+        and nan. The rules that change some of these values must be disabled by default. """
+    def init(self):
+        for dtype in ["np.float32", "np.float64"]:
+            yield "a = M.array([-0.0, 0.0, -np.inf, np.inf, np.nan, 1.5, -2.0, 1000.0], dtype=%s); " % dtype
+
+    def test_multiply_one(self, cmd):
+        return rewrites(cmd, "Algebraic rewrites", True, "r = 1 / (a * 1)")
+
+    def test_add_zero(self, cmd):
+        return rewrites(cmd, "Algebraic rewrites", False, "r = 1 / (a + 0.0)")
+
+    def test_add_negative_zero(self, cmd):
+        return rewrites(cmd, "Algebraic rewrites", True, "r = 1 / (a + -0.0)")
+
+    def test_subtract_zero(self, cmd):
+        return rewrites(cmd, "Algebraic rewrites", True, "r = 1 / (a - 0.0)")
+
+    def test_subtract_self(self, cmd):
+        return rewrites(cmd, "Algebraic rewrites", False, "r = a - a")
+
+    def test_pow_sqrt(self, cmd):
+        return rewrites(cmd, "Algebraic rewrites", False, "r = 1 / a ** 0.5")
+
+    def test_pow_reciprocal(self, cmd):
+        return rewrites(cmd, "Algebraic rewrites", True, "r = a ** -1")
+
+    def test_powk(self, cmd):
+        return rewrites(cmd, "Algebraic rewrites", False, "r = a ** 3.0")
+
+    def test_integer_powk(self, cmd):
+        """ The bcexp filter expands the integer powers unless the output is the input """
+        return rewrites(cmd, "Algebraic rewrites", True, "r = M.arange(10); r **= 3")
+
+    def test_integer_powk_large_exponent(self, cmd):
+        return rewrites(cmd, "Algebraic rewrites", False, "r = M.arange(3); r **= 101")
+
+    def test_log_exp(self, cmd):
+        return rewrites(cmd, "Algebraic rewrites", False, "r = M.log(M.exp(a))")
+
+    def test_integer_self_cancel(self, cmd):
+        return rewrites(cmd, "Algebraic rewrites", True, "b = M.arange(10); r = b - b")
+
+    def test_integer_overlapping_views(self, cmd):
+        return rewrites(cmd, "Algebraic rewrites", False, "b = M.arange(10); r = b[1:] - b[:-1]")
+
+    def test_extmethod(self, cmd):
+        return rewrites(cmd, "Algebraic rewrites", False, "b = M.arange(9).reshape(3, 3); r = M.matmul(b, b)")
+
+
+class test_reduction:
+    """ Chains of reductions over adjacent axes must merge into one reduction when the strides allow it """
+    def init(self):
+        for dtype in ["np.float64", "np.int64"]:
+            yield "a = (M.arange(4 * 5 * 6) %% 7).astype(%s).reshape(4, 5, 6); " % dtype
+
+    def test_all_axes(self, cmd):
+        return rewrites(cmd, "Merged reductions", True, "r = M.add.reduce(M.add.reduce(a, axis=2), axis=1)")
+
+    def test_sum(self, cmd):
+        return rewrites(cmd, "Merged reductions", True, "r = M.sum(a, axis=(1, 2))")
+
+    def test_apart_axes(self, cmd):
+        return rewrites(cmd, "Merged reductions", False, "r = M.sum(a, axis=(0, 2))")
+
+    def test_transposed(self, cmd):
+        return rewrites(cmd, "Merged reductions", False, "r = M.sum(a.transpose(0, 2, 1), axis=(1, 2))")
+
+    def test_strided(self, cmd):
+        return rewrites(cmd, "Merged reductions", False, "r = M.sum(a[:, ::2, :], axis=(1, 2))")
+
+    def test_extmethod(self, cmd):
+        src = "b = a[:, :, :5].copy(); r = M.sum(M.matmul(b, b), axis=(1, 2))"
+        return rewrites(cmd, "Merged reductions", True, src)
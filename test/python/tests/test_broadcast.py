@@ -0,0 +1,25 @@
+class test_broadcast:
+    """ Views that are broadcast along the inner axes, which the enclosing loop might load once together with the
+        instructions that only depend on them """
+    def init(self):
+        for dtype in ["np.float32", "np.float64"]:
+            for shape in ["(10, 50)", "(4, 5, 30)"]:
+                yield "R = bh.random.RandomState(42); a = R.random(%s, dtype=%s, bohrium=BH) + 1; " % (shape, dtype)
+
+    def test_row_normalization(self, cmd):
+        return cmd + "res = a / a.sum(axis=-1)[..., None]"
+
+    def test_column_normalization(self, cmd):
+        return cmd + "res = a / a.sum(axis=0)[None, ...]"
+
+    def test_subexpression(self, cmd):
+        return cmd + "s = a.sum(axis=-1)[..., None]; res = a * (M.sqrt(s) + 1) - M.exp(s / 100)"
+
+    def test_outer(self, cmd):
+        return cmd + "res = a[:, None, ...] * a[:, 0, None, None]"
+
+    def test_written_before(self, cmd):
+        return cmd + "b = a[..., 0] * 2; res = a / b[..., None] + b[..., None]"
+
+    def test_reduce(self, cmd):
+        return cmd + "res = M.add.reduce(a * M.log(a[..., 0, None]), axis=-1)"
@@ -0,0 +1,21 @@
+import util
+
+
+class test_spmv_csr:
+    def init(self):
+        for dtype in util.TYPES.ALL:
+            for nrows, ncols, density in [(50, 40, 0.1), (1, 100, 0.5), (100, 1, 0.5), (30, 30, 0.0)]:
+                cmd = "np.random.seed(42); "
+                cmd += "A = (np.random.random((%d, %d)) < %f) * np.random.randint(1, 10, (%d, %d)); " % \
+                       (nrows, ncols, density, nrows, ncols)
+                cmd += "A = A.astype(%s); A[0, :] = 1; " % dtype  # A dense first row
+                cmd += "x = np.random.randint(1, 10, %d).astype(%s); " % (ncols, dtype)
+                cmd += "rows, cols = np.nonzero(A); "
+                cmd += "indptr = np.concatenate(([0], np.cumsum(np.bincount(rows, minlength=%d)))); " % nrows
+                yield cmd
+
+    def test_spmv(self, cmd):
+        cmd_np = cmd + "res = A.dot(x)"
+        cmd_bh = cmd + "res = bh.linalg.spmv_csr(bh.array(indptr), bh.array(cols), bh.array(A[rows, cols]), " \
+                       "bh.array(x))"
+        return cmd_np, cmd_bh
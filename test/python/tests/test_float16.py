@@ -0,0 +1,33 @@
+import util
+
+
+class test_float16_arithmetic:
+    def init(self):
+        for op in ["+", "-", "*", "/"]:
+            yield ("a = M.arange(1, 65, 1).astype(np.float16); b = M.arange(64, 0, -1).astype(np.float16); ", op)
+
+    def test_arithmetic(self, arg):
+        (cmd, op) = arg
+        return cmd + "res = a %s b" % op
+
+
+class test_float16_ufunc:
+    def init(self):
+        for func in ["sqrt", "exp", "absolute", "negative"]:
+            yield ("a = M.arange(1, 11, 1).astype(np.float16); ", func)
+
+    def test_ufunc(self, arg):
+        (cmd, func) = arg
+        return cmd + "res = M.%s(a)" % func
+
+
+class test_float16_typecast:
+    def init(self):
+        for dtype in util.TYPES.FLOAT + util.TYPES.SIGNED_INT:
+            yield "a = M.arange(-10, 10, 1, dtype=%s); " % dtype
+
+    def test_to_float16(self, cmd):
+        return cmd + "res = a.astype(np.float16)"
+
+    def test_from_float16(self, cmd):
+        return cmd + "res = a.astype(np.float16).astype(np.float64)"
@@ -52,4 +52,105 @@ res = M.ones_like(a)
         """Test of the do_while function"""
         (cmd, niter) = args
 
-        return (cmd + "do_while(kernel, %s, a, res)" % (niter), cmd + "M.do_while(kernel, %s, a, res)" % (niter))
\ No newline at end of file
+        return (cmd + "do_while(kernel, %s, a, res)" % (niter), cmd + "M.do_while(kernel, %s, a, res)" % (niter))
+
+class test_loop_invariant:
+    """ Test loops where some instructions don't change between the iterations """
+    def init(self):
+        cmd = np_loop_src + """
+def kernel(a, b, res):
+    t = M.sin(a) * 2
+    res += t * b
+    b += 1
+
+def kernel_extmethod(a, b, res):
+    res += M.matmul(a, a) + M.matmul(a, b)
+    b += 0.5
+
+a = M.arange(9, dtype=np.float64).reshape(3, 3) / 10
+b = M.ones_like(a)
+res = M.zeros_like(a)
+
+"""
+        yield (cmd)
+
+    def test_invariant(self, cmd):
+        """ The sine is loop-invariant """
+        return (cmd + "do_while(kernel, 5, a, b, res)", cmd + "M.do_while(kernel, 5, a, b, res)")
+
+    def test_extmethod(self, cmd):
+        """ The first matmul has loop-invariant inputs but it is an extension method """
+        return (cmd + "do_while(kernel_extmethod, 5, a, b, res)", cmd + "M.do_while(kernel_extmethod, 5, a, b, res)")
+
+
+class test_loop_stencil:
+    """ Test repeated stencils, which temporal blocking might run as wavefronts over the rows """
+    def init(self):
+        cmd = np_loop_src + """
+def jacobi(a, b):
+    b[1:-1, 1:-1] = (a[:-2, 1:-1] + a[2:, 1:-1] + a[1:-1, :-2] + a[1:-1, 2:]) / 4
+    a[1:-1, 1:-1] = (b[:-2, 1:-1] + b[2:, 1:-1] + b[1:-1, :-2] + b[1:-1, 2:]) / 4
+
+def jacobi_cond(a, b):
+    jacobi(a, b)
+    return M.sum(a) < 2000
+
+a = M.arange(20 * 30, dtype=np.float64).reshape(20, 30) / 100
+b = a.copy()
+
+"""
+        for niters in [1, 4, 10, 13]:
+            yield (cmd, niters)
+
+    def _loop(self, cmd, src):
+        return (cmd + src, cmd + src.replace("do_while(", "M.do_while("))
+
+    def test_jacobi(self, args):
+        (cmd, niters) = args
+        return self._loop(cmd, "do_while(jacobi, %d, a, b); res = a + b" % niters)
+
+    def test_not_row_aligned(self, args):
+        """ The views start in the middle of a row of the underlying array """
+        (cmd, niters) = args
+        cmd += "v = a.reshape(-1)[7:7 + 18 * 31].reshape(18, 31); w = b.reshape(-1)[7:7 + 18 * 31].reshape(18, 31); "
+        return self._loop(cmd, "do_while(jacobi, %d, v, w); res = a + b" % niters)
+
+    def test_condition(self, args):
+        """ A repeat condition runs as the regular repeat loop """
+        (cmd, niters) = args
+        return self._loop(cmd, "do_while(jacobi_cond, %d, a, b); res = a + b" % niters)
+
+
+class test_loop_flush:
+    """ Test Python loops that flush the same instructions in each iteration, which bccon might find as repeats """
+    def init(self):
+        cmd = """
+a = M.arange(100, dtype=np.float64) / 10
+res = M.zeros_like(a)
+
+"""
+        yield cmd
+
+    def _loop(self, cmd, src):
+        return ("def flush(): pass\n" + cmd + src, "flush = bh.flush\n" + cmd + src)
+
+    def test_unrolled(self, cmd):
+        src = """
+for i in range(10):
+    res += M.sin(a) * 2 + a
+    a += 1
+    flush()
+"""
+        return self._loop(cmd, src)
+
+    def test_changing_body(self, cmd):
+        """ The loop body changes in the middle of the iterations """
+        src = """
+for i in range(10):
+    res += M.sin(a) * 2 + a
+    a += 1
+    if i == 6:
+        res *= 0.5
+    flush()
+"""
+        return self._loop(cmd, src)
@@ -92,6 +92,16 @@ class test_where:
         cmd += "res = M.where(m, a, b)"
         return cmd
 
+    def test_scalars(self, arg):
+        (cmd, dtype) = arg
+        cmd += "res = M.where(m, %s(42), %s(7))" % (dtype, dtype)
+        return cmd
+
+    def test_broadcast(self, arg):
+        (cmd, dtype) = arg
+        cmd += "res = M.where(m, a, b[..., :1])"
+        return cmd
+
     def test_nan_array(self, arg):
         (cmd, dtype) = arg
         if dtype in util.TYPES.FLOAT:
@@ -110,3 +120,36 @@ class test_where:
         (cmd, dtype) = arg
         cmd += "res = M.where(m, a, M.nan)"
         return cmd
+
+
+class test_packed_mask:
+    """ Boolean arrays might be stored bit-packed, thus test masks whose lengths aren't a multiple of 32 """
+    def init(self):
+        for n in [33, 63, 100]:
+            yield "a = (M.arange(%d) * 7 %% 11).astype(np.float64); m = a > 4; " % n
+
+    def _flush(self, cmd, src):
+        """ The Bohrium command flushes the mask before `src` reads it """
+        return (cmd + src, cmd + "bh.flush(); " + src)
+
+    def test_count(self, cmd):
+        return self._flush(cmd, "res = M.sum(m.astype(np.int64))")
+
+    def test_any(self, cmd):
+        return self._flush(cmd, "res = M.any(m)")
+
+    def test_any_false(self, cmd):
+        return self._flush(cmd + "f = a > 100; ", "res = M.any(f)")
+
+    def test_all(self, cmd):
+        return self._flush(cmd, "res = M.all(m)")
+
+    def test_all_true(self, cmd):
+        """ The padding bits of the last word must not count """
+        return self._flush(cmd + "t = a > -1; ", "res = M.all(t)")
+
+    def test_extmethod(self, cmd):
+        return self._flush(cmd, "res = M.concatenate([a[m], M.flatnonzero(m).astype(np.float64)])")
+
+    def test_scatter(self, cmd):
+        return self._flush(cmd, "M.put(m, M.arange(0, m.size, 3), False); res = m")
@@ -0,0 +1,48 @@
+import util
+
+
+class test_matmul:
+    def init(self):
+        for dtype in util.TYPES.ALL:
+            for a_shape, b_shape in [((10, 20), (20, 30)), ((70, 300), (300, 5)), ((1, 1), (1, 1)),
+                                     ((3, 4, 5), (3, 5, 6)), ((2, 1, 4, 5), (3, 5, 6)), ((4, 5), (2, 5, 6))]:
+                cmd = "R = bh.random.RandomState(42); "
+                cmd += "a = R.random(%s, dtype=%s, bohrium=BH); " % (a_shape, dtype)
+                cmd += "b = R.random(%s, dtype=%s, bohrium=BH); " % (b_shape, dtype)
+                yield cmd
+
+    def test_matmul(self, cmd):
+        return cmd + "res = M.matmul(a, b)"
+
+    def test_transposed(self, cmd):
+        return cmd + "res = M.matmul(M.swapaxes(b, -1, -2), M.swapaxes(a, -1, -2))"
+
+
+class test_matmul_vector:
+    def init(self):
+        for dtype in util.TYPES.ALL:
+            cmd = "R = bh.random.RandomState(42); "
+            cmd += "a = R.random((30, 40), dtype=%s, bohrium=BH); " % dtype
+            cmd += "v = R.random((40,), dtype=%s, bohrium=BH); " % dtype
+            yield cmd
+
+    def test_matvec(self, cmd):
+        return cmd + "res = M.matmul(a, v)"
+
+    def test_vecmat(self, cmd):
+        return cmd + "res = M.matmul(v, a.T)"
+
+    def test_dot(self, cmd):
+        return cmd + "res = M.dot(a, a.T)"
+
+
+class test_matmul_overflow:
+    """ Integer matrix multiplications wrap around on overflow like NumPy """
+    def init(self):
+        for dtype in ["np.int8", "np.int16", "np.int32", "np.int64", "np.uint8"]:
+            cmd = "a = (M.arange(70 * 300) %% 251 - 125).astype(%s).reshape(70, 300) * 127; " % dtype
+            cmd += "b = (M.arange(300 * 5) %% 13 - 6).astype(%s).reshape(300, 5) * 127; " % dtype
+            yield cmd
+
+    def test_matmul(self, cmd):
+        return cmd + "res = M.matmul(a, b)"
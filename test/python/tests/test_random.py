@@ -0,0 +1,49 @@
+class test_distributions:
+    """ The Bohrium kernels must draw the same numbers as the NumPy fallback (`bohrium=False`) """
+    def init(self):
+        for dtype in ["np.float32", "np.float64"]:
+            for size in ["1", "100", "(10, 20)"]:
+                yield ("R = bh.random.RandomState(42); ", dtype, size)
+
+    def test_random_sample(self, arg):
+        (cmd, dtype, size) = arg
+        return cmd + "res = R.random_sample(%s, dtype=%s, bohrium=BH)" % (size, dtype)
+
+    def test_standard_normal(self, arg):
+        (cmd, dtype, size) = arg
+        return cmd + "res = R.standard_normal(%s, dtype=%s, bohrium=BH)" % (size, dtype)
+
+    def test_normal(self, arg):
+        (cmd, dtype, size) = arg
+        return cmd + "res = R.normal(2.0, 3.0, %s, dtype=%s, bohrium=BH)" % (size, dtype)
+
+    def test_consecutive(self, arg):
+        (cmd, dtype, size) = arg
+        cmd += "a = R.standard_normal(%s, dtype=%s, bohrium=BH); " % (size, dtype)
+        return cmd + "res = R.random_sample(%s, dtype=%s, bohrium=BH) + a" % (size, dtype)
+
+
+class test_randint:
+    def init(self):
+        for dtype in ["np.int32", "np.int64", "np.uint64"]:
+            for low, high in [(0, 2), (-5, 10), (0, 2 ** 32), (0, 2 ** 40)]:
+                if dtype == "np.int32" and high > 2 ** 31:
+                    continue
+                yield "R = bh.random.RandomState(42); res = R.randint(%d, %d, 1000, dtype=%s, bohrium=BH)" % \
+                      (low, high, dtype)
+
+    def test_randint(self, cmd):
+        return cmd
+
+
+class test_monte_carlo:
+    """ The random numbers are generated within the kernel that reduces them """
+    def init(self):
+        yield "R = bh.random.RandomState(42); "
+
+    def test_pi(self, cmd):
+        cmd += "x = R.random_sample(10000, bohrium=BH); y = R.random_sample(10000, bohrium=BH); "
+        return cmd + "res = M.sum(x * x + y * y < 1.0) * 4.0 / 10000"
+
+    def test_mean_of_normals(self, cmd):
+        return cmd + "res = M.mean(M.exp(R.standard_normal(10000, bohrium=BH) * 0.1))"
@@ -81,6 +81,12 @@ class test_nonzero:
     def test_nonzero(self, cmd):
         return cmd + "res = M.concatenate(M.nonzero(a))"
 
+    def test_flatnonzero_mask(self, cmd):
+        return cmd + "res = M.flatnonzero(a > 0.5)"
+
+    def test_flatnonzero_empty(self, cmd):
+        return cmd + "res = M.flatnonzero(a > 2)"
+
 
 class test_fancy_indexing_get:
     def init(self):
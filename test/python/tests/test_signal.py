@@ -22,6 +22,25 @@ class test_1d:
         return cmd
 
 
+class test_1d_types:
+    def init(self):
+        for mode in ['same', 'valid', 'full']:
+            for dtype in util.TYPES.ALL_INT + util.TYPES.COMPLEX:
+                for a_size, v_size in [(100, 7), (8, 30), (1, 1)]:
+                    cmd = "R = bh.random.RandomState(42); "
+                    cmd += "a = R.random(%d, dtype=%s, bohrium=BH); " % (a_size, dtype)
+                    cmd += "v = R.random(%d, dtype=%s, bohrium=BH); " % (v_size, dtype)
+                    yield (cmd, mode)
+
+    def test_correlate(self, args):
+        (cmd, mode) = args
+        return cmd + "res = M.correlate(a, v, mode='%s')" % mode
+
+    def test_convolve(self, args):
+        (cmd, mode) = args
+        return cmd + "res = M.convolve(a, v, mode='%s')" % mode
+
+
 class _test_scipy:
     def init(self):
         for mode in ['valid', 'full', 'same']:
@@ -0,0 +1,65 @@
+import util
+
+
+class test_sort:
+    def init(self):
+        for dtype in util.TYPES.ALL:
+            for cmd, shape in util.gen_random_arrays("R", 3, max_dim=50, dtype=dtype):
+                for axis in range(-1, len(shape)):
+                    yield ("R = bh.random.RandomState(42); a = %s; " % cmd, axis)
+
+    def test_sort(self, arg):
+        (cmd, axis) = arg
+        return cmd + "res = M.sort(a, axis=%d)" % axis
+
+    def test_argsort(self, arg):
+        (cmd, axis) = arg
+        return cmd + "res = M.argsort(a, axis=%d, kind='mergesort')" % axis
+
+
+class test_sort_flatten:
+    def init(self):
+        for dtype in util.TYPES.ALL:
+            for cmd, shape in util.gen_random_arrays("R", 3, max_dim=50, dtype=dtype):
+                yield "R = bh.random.RandomState(42); a = %s; " % cmd
+
+    def test_sort(self, cmd):
+        return cmd + "res = M.sort(a, axis=None)"
+
+    def test_argsort(self, cmd):
+        return cmd + "res = M.argsort(a, axis=None, kind='mergesort')"
+
+
+class test_sort_special:
+    def init(self):
+        yield "a = M.array([3, 1, 2, 1, 3, 0, 1, 2], dtype=np.int64); "
+        yield "a = M.array([3.0, M.nan, -0.0, 0.0, -M.inf, 1.5, M.nan, M.inf, -2.0]); "
+        yield "a = M.array([1+2j, M.nan, 1+1j, 0+5j, 1, complex(1, M.nan)]); "
+        yield "a = M.arange(200000, dtype=np.int32) % 1000 - 500; "
+
+    def test_sort(self, cmd):
+        return cmd + "res = M.sort(a)"
+
+    def test_argsort(self, cmd):
+        return cmd + "res = M.argsort(a, kind='mergesort')"
+
+    def test_unique(self, cmd):
+        return cmd + "res = M.unique(a)"
+
+
+class test_searchsorted:
+    def init(self):
+        yield "a = M.sort(M.arange(100, dtype=np.int64) * 7 % 13); v = M.arange(-2, 16, dtype=np.int64); "
+        yield "a = M.sort(M.arange(33) * 0.25 % 2); v = M.arange(-1, 3, 0.125); "
+        yield "a = M.array([-M.inf, -2.0, 0.0, 0.0, 1.5, M.inf, M.nan, M.nan]); " \
+              "v = M.array([M.nan, -M.inf, 0.0, 1.0, M.inf, -3.0]); "
+        yield "a = M.array([5], dtype=np.int64); v = M.arange(10, dtype=np.int64).reshape(2, 5); "
+
+    def test_left(self, cmd):
+        return cmd + "res = M.searchsorted(a, v)"
+
+    def test_right(self, cmd):
+        return cmd + "res = M.searchsorted(a, v, side='right')"
+
+    def test_sorter(self, cmd):
+        return cmd + "b = a[::-1].copy(); res = M.searchsorted(b, v, sorter=M.argsort(b, kind='mergesort'))"
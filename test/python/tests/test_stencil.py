@@ -0,0 +1,26 @@
+class test_stencil:
+    """ Stencils of views that are shifted along the innermost axis, which the innermost loop might load through
+        a sliding window """
+    def init(self):
+        for dtype in ["np.float32", "np.float64", "np.int64"]:
+            for shape in ["(10, 50)", "(4, 5, 30)"]:
+                yield "R = bh.random.RandomState(42); a = R.random(%s, dtype=%s, bohrium=BH); " % (shape, dtype)
+
+    def test_three_point(self, cmd):
+        return cmd + "res = a[..., :-2] + a[..., 1:-1] + a[..., 2:]"
+
+    def test_five_point(self, cmd):
+        cmd += "res = a[1:-1, ..., 1:-1] * 4 - a[:-2, ..., 1:-1] - a[2:, ..., 1:-1] - a[1:-1, ..., :-2] "
+        return cmd + "- a[1:-1, ..., 2:]"
+
+    def test_gaps(self, cmd):
+        return cmd + "res = a[..., :-9] - a[..., 3:-6] * a[..., 4:-5] + a[..., 9:]"
+
+    def test_strided(self, cmd):
+        return cmd + "res = a[..., :-4:2] + a[..., 2:-2:2] + a[..., 4::2]"
+
+    def test_reversed(self, cmd):
+        return cmd + "b = a[..., ::-1]; res = b[..., :-2] + b[..., 1:-1] * b[..., 2:]"
+
+    def test_reduce(self, cmd):
+        return cmd + "res = M.add.reduce(a[..., :-1] * a[..., 1:], axis=-1)"
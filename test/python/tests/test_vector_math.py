@@ -0,0 +1,99 @@
+class test_accuracy:
+    """ The math functions must stay within 4 ulp of the reference, which NumPy computes in a wider type, such that
+        the SIMD variants of the `fast_math = ulp` policy are as accurate as promised """
+    def init(self):
+        for dtype, wide in [("np.float32", "np.float64"), ("np.float64", "np.longdouble")]:
+            cmd = "R = bh.random.RandomState(42); N = (lambda a: a.copy2numpy()) if BH else (lambda a: a); "
+            yield (cmd, dtype, wide)
+
+    def _ulp(self, arg, func, low, high, ref=None):
+        (cmd, dtype, wide) = arg
+        cmd += "x = R.uniform(%s, %s, 10000, dtype=%s, bohrium=BH); " % (low, high, dtype)
+        cmd += "y = N(M.%s(x)).astype(%s); r = np.%s(N(x).astype(%s)); " % (func, wide, ref or func, wide)
+        return cmd + "res = np.max(np.abs(y - r) / np.spacing(np.abs(r).astype(%s))) <= 4" % dtype
+
+    def test_exp(self, arg):
+        return self._ulp(arg, "exp", -80, 80)
+
+    def test_exp2(self, arg):
+        return self._ulp(arg, "exp2", -120, 120)
+
+    def test_expm1(self, arg):
+        return self._ulp(arg, "expm1", -10, 10)
+
+    def test_log(self, arg):
+        return self._ulp(arg, "log", 1e-3, 1e6)
+
+    def test_log2(self, arg):
+        return self._ulp(arg, "log2", 1e-3, 1e6)
+
+    def test_log10(self, arg):
+        return self._ulp(arg, "log10", 1e-3, 1e6)
+
+    def test_log1p(self, arg):
+        return self._ulp(arg, "log1p", -0.5, 100)
+
+    def test_sin(self, arg):
+        return self._ulp(arg, "sin", -100, 100)
+
+    def test_cos(self, arg):
+        return self._ulp(arg, "cos", -100, 100)
+
+    def test_tan(self, arg):
+        return self._ulp(arg, "tan", -1.5, 1.5)
+
+    def test_arcsin(self, arg):
+        return self._ulp(arg, "arcsin", -1, 1)
+
+    def test_arccos(self, arg):
+        return self._ulp(arg, "arccos", -1, 1)
+
+    def test_arctan(self, arg):
+        return self._ulp(arg, "arctan", -100, 100)
+
+    def test_sinh(self, arg):
+        return self._ulp(arg, "sinh", -80, 80)
+
+    def test_cosh(self, arg):
+        return self._ulp(arg, "cosh", -80, 80)
+
+    def test_tanh(self, arg):
+        return self._ulp(arg, "tanh", -10, 10)
+
+    def test_arcsinh(self, arg):
+        return self._ulp(arg, "arcsinh", -100, 100)
+
+    def test_arccosh(self, arg):
+        return self._ulp(arg, "arccosh", 1, 100)
+
+    def test_arctanh(self, arg):
+        return self._ulp(arg, "arctanh", -0.99, 0.99)
+
+    def test_power(self, arg):
+        (cmd, dtype, wide) = arg
+        cmd += "x = R.uniform(0.01, 10, 10000, dtype=%s, bohrium=BH); " % dtype
+        cmd += "e = R.uniform(-5, 5, 10000, dtype=%s, bohrium=BH); " % dtype
+        cmd += "y = N(M.power(x, e)).astype(%s); r = np.power(N(x).astype(%s), N(e).astype(%s)); " % (wide, wide, wide)
+        return cmd + "res = np.max(np.abs(y - r) / np.spacing(np.abs(r).astype(%s))) <= 4" % dtype
+
+
+class test_special_values:
+    """ NaN, infinity, and overflow must be handled like libm """
+    def init(self):
+        for dtype in ["np.float32", "np.float64"]:
+            yield "a = M.array([np.nan, np.inf, -np.inf, 0.0, -0.0, 1000.0, -1000.0], dtype=%s); " % dtype
+
+    def test_exp(self, cmd):
+        return cmd + "res = M.exp(a)"
+
+    def test_log(self, cmd):
+        return cmd + "res = M.log(M.abs(a))"
+
+    def test_sin(self, cmd):
+        return cmd + "res = M.sin(a)"
+
+    def test_tanh(self, cmd):
+        return cmd + "res = M.tanh(a)"
+
+    def test_power(self, cmd):
+        return cmd + "res = M.power(a, 2.5)"
@@ -214,6 +214,9 @@ void EngineCUDA::writeKernel(const jitk::Block &block,
     if (symbols.useRandom()) { // Write the random function
         ss << "#include <kernel_dependencies/random123_cuda.h>\n";
     }
+    if (symbols.useHalf()) {
+        ss << "#include <kernel_dependencies/float16.h>\n";
+    }
     ss << "\n";
 
     // Write the header of the execute function
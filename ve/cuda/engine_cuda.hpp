@@ -246,6 +246,8 @@ public:
             case bh_type::COMPLEX64:  return "cuFloatComplex";
             case bh_type::COMPLEX128: return "cuDoubleComplex";
             case bh_type::R123:       return "ulong2";
+            case bh_type::FLOAT16:    return "unsigned short"; // Converted by `kernel_dependencies/float16.h`
+            case bh_type::BFLOAT16:   return "unsigned short";
             default:
                 std::cerr << "Unknown CUDA type: " << bh_type_text(dtype) << std::endl;
                 throw std::runtime_error("Unknown CUDA type");
@@ -354,6 +354,12 @@ void EngineOpenCL::execute(const std::string &source,
             case bh_type::R123:
                 opencl_kernel.setArg(i++, instr->constant.value.r123);
                 break;
+            case bh_type::FLOAT16:
+                opencl_kernel.setArg(i++, instr->constant.value.float16.bits);
+                break;
+            case bh_type::BFLOAT16:
+                opencl_kernel.setArg(i++, instr->constant.value.bfloat16.bits);
+                break;
             default:
                 std::cerr << "Unknown OpenCL type: " << bh_type_text(instr->constant.type) << std::endl;
                 throw std::runtime_error("Unknown OpenCL type");
@@ -448,6 +454,9 @@ void EngineOpenCL::writeKernel(const jitk::Block &block,
     if (symbols.useRandom()) { // Write the random function
         ss << "#include <kernel_dependencies/random123_opencl.h>\n";
     }
+    if (symbols.useHalf()) {
+        ss << "#include <kernel_dependencies/float16.h>\n";
+    }
     ss << "\n";
 
     // Write the header of the execute function
@@ -540,6 +549,8 @@ const std::string EngineOpenCL::writeType(bh_type dtype) {
         case bh_type::COMPLEX64:  return "float2";
         case bh_type::COMPLEX128: return "double2";
         case bh_type::R123:       return "ulong2";
+        case bh_type::FLOAT16:    return "ushort"; // Converted by `kernel_dependencies/float16.h`
+        case bh_type::BFLOAT16:   return "ushort";
         default:
             std::cerr << "Unknown OpenCL type: " << bh_type_text(dtype) << std::endl;
             throw std::runtime_error("Unknown OpenCL type");
@@ -24,6 +24,7 @@ If not, see <http://www.gnu.org/licenses/>.
 #include <string>
 #include <map>
 #include <iomanip>
+#include <algorithm>
 #include <dlfcn.h>
 #include <jitk/codegen_util.hpp>
 #include <jitk/compiler.hpp>
@@ -41,11 +42,48 @@ namespace fs = boost::filesystem;
 
 namespace bohrium {
 
+namespace {
+// Returns the `fast_math` policy of 'config'
+string fast_math_policy(const ConfigParser &config) {
+    const string policy = config.defaultGet<string>("fast_math", "off");
+    if (policy != "off" and policy != "ulp" and policy != "fast") {
+        throw runtime_error("VE-OPENMP: `fast_math` must be off, ulp, or fast but is '" + policy + "'");
+    }
+    return policy;
+}
+
+// Returns the compile command of 'config' including the flags of the 'fast_math' policy
+string compile_command(const ConfigParser &config, const string &fast_math) {
+    string cmd = config.get<string>("compiler_cmd");
+    if (fast_math == "fast") {
+        cmd += " -ffast-math";
+    }
+#if defined(__GLIBC__) && defined(__x86_64__)
+    if (fast_math != "off") { // The SIMD variants of the math functions
+        cmd += " -lmvec";
+    }
+#endif
+    return cmd;
+}
+
+// Number of iterations that a loop with non-temporal stores computes into its buffers before writing them
+constexpr uint64_t streaming_strip = 64;
+} // Anon namespace
+
 EngineOpenMP::EngineOpenMP(const ConfigParser &config, jitk::Statistics &stat) :
     EngineCPU(config, stat),
-    compiler(config.get<string>("compiler_cmd"), verbose, config.file_dir.string())
+    fast_math(fast_math_policy(config)),
+    compiler(compile_command(config, fast_math), verbose, config.file_dir.string())
 {
     compilation_hash = util::hash(compiler.cmd_template);
+
+    if (config.defaultGet<bool>("thread_pool", false)) {
+        _thread_pool.reset(new ThreadPool(config.defaultGet<uint64_t>("thread_pool_size", 0),
+                                          config.defaultGet<bool>("thread_pool_pinning", true),
+                                          config.defaultGet<uint64_t>("thread_pool_chunks", 4)));
+        // Since the pool is part of the hash, kernels with and without the pool never share a cache file
+        compilation_hash = util::hash("thread_pool", compilation_hash);
+    }
 }
 
 EngineOpenMP::~EngineOpenMP() {
@@ -76,6 +114,19 @@ EngineOpenMP::~EngineOpenMP() {
         util::remove_old_files(cache_bin_dir, cache_file_max);
     }
 
+    // When using the thread pool, the kernels never start an OpenMP runtime thus
+    // we can stop the pool and unload the kernels safely
+    if (_thread_pool) {
+        _thread_pool.reset();
+        for(void *handle: _lib_handles) {
+            dlerror(); // Reset errors
+            if (dlclose(handle)) {
+                cerr << dlerror() << endl;
+            }
+        }
+        return;
+    }
+
     // If this cleanup is enabled, the application segfaults
     // on destruction of the EngineOpenMP class.
     //
@@ -157,7 +208,8 @@ void EngineOpenMP::execute(const std::string &source,
                            uint64_t codegen_hash,
                            const std::vector<bh_base*> &non_temps,
                            const std::vector<const bh_view*> &offset_strides,
-                           const std::vector<const bh_instruction*> &constants) {
+                           const std::vector<const bh_instruction*> &constants,
+                           const jitk::KernelRepeat &repeat) {
     // Notice, we use a "pure" hash of `source` to make sure that the `source_filename` always
     // corresponds to `source` even if `codegen_hash` is buggy.
     uint64_t hash = util::hash(source);
@@ -197,14 +249,24 @@ void EngineOpenMP::execute(const std::string &source,
 
     // And the constants
     vector<bh_constant_value> constant_arg;
-    constant_arg.reserve(constants.size());
+    constant_arg.reserve(constants.size() + 1);
     for (const bh_instruction* instr: constants) {
         constant_arg.push_back(instr->constant.value);
     }
+    if (repeat.enabled()) {
+        constant_arg.emplace_back(repeat.nrepeats);
+    }
 
     auto start_exec = chrono::steady_clock::now();
     // Call the launcher function, which will execute the kernel
-    func(&data_list[0], &offset_and_strides[0], &constant_arg[0]);
+    if (_thread_pool) {
+        // NB: the launcher of a pool kernel has another signature, thus we cast through `void*`
+        PoolKernelFunction pool_func = reinterpret_cast<PoolKernelFunction>(reinterpret_cast<void *>(func));
+        pool_func(&data_list[0], &offset_and_strides[0], &constant_arg[0],
+                  &ThreadPool::parallelForTrampoline, _thread_pool.get());
+    } else {
+        func(&data_list[0], &offset_and_strides[0], &constant_arg[0]);
+    }
     auto texec = chrono::steady_clock::now() - start_exec;
     stat.time_exec += texec;
     stat.time_per_kernel[source_filename].register_exec_time(texec);
@@ -223,6 +285,25 @@ void EngineOpenMP::loopHeadWriter(const jitk::SymbolTable &symbols,
                                   bool loop_is_peeled,
                                   const vector<uint64_t> &thread_stack,
                                   stringstream &out) {
+    // In a temporal blocking wavefront, the outermost loop only executes the row given by the wavefront
+    if (_wavefront_shift >= 0 and block.rank == 0) {
+        out << "if (wavefront >= " << _wavefront_shift << " && wavefront < " << block.size + _wavefront_shift << ") ";
+        out << "for(uint64_t i0 = wavefront - " << _wavefront_shift << "; i0 <= wavefront - " << _wavefront_shift
+            << "; ++i0) {\n";
+        return;
+    }
+
+    // Outputs larger than the last-level cache are written with non-temporal stores
+    const vector<const bh_view*> streamed = jitk::streamed_outputs(symbols, block, scope.parent,
+                                                                   streaming_store_threshold);
+    if (not streamed.empty()) {
+        for (const bh_view *view: streamed) {
+            scope.insertStreamed(*view);
+        }
+        writeStreamingLoopHead(symbols, scope, block, out);
+        return;
+    }
+
     // Let's write the OpenMP loop header
     int64_t for_loop_size = block.size;
     // If the for-loop has been peeled, its size is one less
@@ -236,6 +317,12 @@ void EngineOpenMP::loopHeadWriter(const jitk::SymbolTable &symbols,
     // Write the for-loop header
     string itername;
     { stringstream t; t << "i" << block.rank; itername = t.str(); }
+    // When using the thread pool, the outermost loop only covers the chunk given by the pool
+    if (_thread_pool and thread_pool_compatible(block)) {
+        out << "for(uint64_t " << itername << " = chunk_begin; " << itername << " < chunk_end; ++"
+            << itername << ") {\n";
+        return;
+    }
     out << "for(uint64_t " << itername;
     if (block._sweeps.size() > 0 and loop_is_peeled) {
          // If the for-loop has been peeled, we should start at 1
@@ -246,6 +333,101 @@ void EngineOpenMP::loopHeadWriter(const jitk::SymbolTable &symbols,
     out << itername << " < " << block.size << "; ++" << itername << ") {\n";
 }
 
+// Writes the header of a loop that computes strips of its iterations into a buffer per streamed output, which
+// `loopTailWriter()` writes to the arrays with non-temporal stores
+void EngineOpenMP::writeStreamingLoopHead(const jitk::SymbolTable &symbols,
+                                          jitk::Scope &scope,
+                                          const jitk::LoopB &block,
+                                          stringstream &out) {
+    const bool openmp = config.defaultGet<bool>("compiler_openmp", false);
+    const bool simd = openmp and config.defaultGet<bool>("compiler_openmp_simd", false) and
+                      simd_compatible(block, scope);
+    const string i = "i" + std::to_string(block.rank);
+    string begin = "0", end = std::to_string(block.size);
+    if (_thread_pool and thread_pool_compatible(block)) {
+        begin = "chunk_begin";
+        end = "chunk_end";
+    } else if (openmp and block.rank == 0 and _stream_fence) {
+        openStreamFenceRegion(out);
+        out << "#pragma omp for nowait\n";
+        util::spaces(out, 4);
+    } else if (openmp and block.rank == 0) {
+        out << "#pragma omp parallel for\n";
+        util::spaces(out, 4);
+    }
+    out << "for(uint64_t " << i << "_nt = " << begin << "; " << i << "_nt < " << end << "; " << i << "_nt += "
+        << streaming_strip << ") {\n";
+    for (const bh_view &view: scope.getStreamed()) {
+        util::spaces(out, 8 + block.rank * 4);
+        out << writeType(view.base->type) << " nt" << symbols.baseID(view.base) << "[" << streaming_strip << "];\n";
+    }
+    util::spaces(out, 8 + block.rank * 4);
+    out << "const uint64_t " << i << "_nt_end = " << i << "_nt + " << streaming_strip << " < " << end << " ? "
+        << i << "_nt + " << streaming_strip << " : " << end << ";\n";
+    util::spaces(out, 8 + block.rank * 4);
+    if (simd) {
+        out << "#pragma omp simd\n";
+        util::spaces(out, 8 + block.rank * 4);
+    }
+    out << "for(uint64_t " << i << " = " << i << "_nt; " << i << " < " << i << "_nt_end; ++" << i << ") {\n";
+    for (const bh_view &view: scope.getStreamed()) {
+        util::spaces(out, 8 + block.rank * 4);
+        scope.writeDeclaration(view, writeType(view.base->type), out);
+        out << "\n";
+    }
+}
+
+void EngineOpenMP::loopTailWriter(const jitk::SymbolTable &symbols,
+                                  const jitk::Scope &scope,
+                                  const jitk::LoopB &block,
+                                  stringstream &out) {
+    if (scope.getStreamed().empty()) {
+        return;
+    }
+    const string i = "i" + std::to_string(block.rank);
+    for (const bh_view &view: scope.getStreamed()) {
+        util::spaces(out, 8 + block.rank * 4);
+        out << "nt" << symbols.baseID(view.base) << "[" << i << " - " << i << "_nt] = ";
+        scope.getName(view, out);
+        out << ";\n";
+    }
+    util::spaces(out, 8 + block.rank * 4);
+    out << "}\n";
+    for (const bh_view &view: scope.getStreamed()) {
+        const size_t id = symbols.baseID(view.base);
+        util::spaces(out, 8 + block.rank * 4);
+        out << "{const uint64_t " << i << " = " << i << "_nt; bh_stream_store(&a" << id;
+        write_array_subscription(scope, view, out, true);
+        out << ", nt" << id << ", sizeof(nt" << id << "), (" << i << "_nt_end - " << i << "_nt) * sizeof(nt" << id
+            << "[0]));}\n";
+    }
+}
+
+void EngineOpenMP::writeOutermostLoop(const jitk::SymbolTable &symbols, const jitk::LoopB &block, stringstream &out) {
+    _stream_fence = hasStreamedOutputs(symbols, block);
+    writeLoopBlock(symbols, nullptr, block, {}, false, out);
+    if (_stream_fence) {
+        util::spaces(out, 4);
+        out << "bh_stream_fence();\n";
+        if (_stream_fence_region) {
+            util::spaces(out, 4);
+            out << "}\n";
+        }
+    }
+    _stream_fence = false;
+    _stream_fence_region = false;
+}
+
+// The loop runs as a "omp for nowait" in the region such that each thread fences its own stores before the barrier
+// at the end of the region
+void EngineOpenMP::openStreamFenceRegion(stringstream &out) {
+    out << "#pragma omp parallel\n";
+    util::spaces(out, 4);
+    out << "{\n";
+    util::spaces(out, 4);
+    _stream_fence_region = true;
+}
+
 // Writing the OpenMP header, which include "parallel for" and "simd"
 void EngineOpenMP::writeHeader(const jitk::SymbolTable &symbols,
                                jitk::Scope &scope,
@@ -264,9 +446,12 @@ void EngineOpenMP::writeHeader(const jitk::SymbolTable &symbols,
     const std::vector<jitk::InstrPtr> ordered_block_sweeps = order_sweep_set(block._sweeps, symbols);
 
     stringstream ss;
-    // "OpenMP for" goes to the outermost loop
-    if (block.rank == 0 and openmp_compatible(block)) {
-        ss << " parallel for";
+    // "OpenMP for" goes to the outermost loop (unless the thread pool handles the parallelism)
+    const bool parallel_for = not _thread_pool and block.rank == 0 and openmp_compatible(block);
+    // NB: the reductions are copied back after the loop, thus they need the barrier at the end of the loop
+    const bool fence_region = parallel_for and _stream_fence and block._sweeps.empty();
+    if (parallel_for) {
+        ss << (fence_region ? " for" : " parallel for");
         // Since we are doing parallel for, we should either do OpenMP reductions or protect the sweep instructions
         for (const jitk::InstrPtr &instr: ordered_block_sweeps) {
             assert(instr->operand.size() == 3);
@@ -284,7 +469,7 @@ void EngineOpenMP::writeHeader(const jitk::SymbolTable &symbols,
     // "OpenMP SIMD" goes to the innermost loop (which might also be the outermost loop)
     if (enable_simd and block.isInnermost() and simd_compatible(block, scope)) {
         ss << " simd";
-        if (block.rank > 0) { // NB: avoid multiple reduction declarations
+        if (not parallel_for) { // NB: avoid multiple reduction declarations
             for (const jitk::InstrPtr &instr: ordered_block_sweeps) {
                 openmp_reductions.push_back(instr);
             }
@@ -298,6 +483,10 @@ void EngineOpenMP::writeHeader(const jitk::SymbolTable &symbols,
         scope.getName(instr->operand[0], ss);
         ss << ")";
     }
+    if (fence_region) {
+        ss << " nowait";
+        openStreamFenceRegion(out);
+    }
     const string ss_str = ss.str();
     if(not ss_str.empty()) {
         out << "#pragma omp" << ss_str << "\n";
@@ -308,6 +497,7 @@ void EngineOpenMP::writeHeader(const jitk::SymbolTable &symbols,
 void EngineOpenMP::writeKernel(const std::vector<jitk::Block> &block_list,
                                const jitk::SymbolTable &symbols,
                                const std::vector<bh_base*> &kernel_temps,
+                               const jitk::KernelRepeat &repeat,
                                uint64_t codegen_hash,
                                std::stringstream &ss) {
 
@@ -318,35 +508,198 @@ void EngineOpenMP::writeKernel(const std::vector<jitk::Block> &block_list,
     ss << "#include <complex.h>\n";
     ss << "#include <tgmath.h>\n";
     ss << "#include <math.h>\n";
+    if (fast_math == "ulp") {
+        ss << "#include <kernel_dependencies/vector_math.h>\n";
+    }
+    if (streaming_store_threshold > 0) {
+        ss << "#include <kernel_dependencies/streaming_store.h>\n";
+    }
     if (symbols.useRandom()) { // Write the random function
         ss << "#include <kernel_dependencies/random123_openmp.h>\n";
     }
+    if (symbols.useHalf()) {
+        ss << "#include <kernel_dependencies/float16.h>\n";
+    }
+    if (symbols.usePacked()) {
+        ss << "#include <kernel_dependencies/bitpack.h>\n";
+    }
     writeUnionType(ss); // We always need to declare the union of all constant data types
     ss << "\n";
 
+    // When using the thread pool, the parallel loop blocks becomes chunk functions that read their
+    // arguments from a struct, which the execute function gives to the pool
+    string args_struct;
+    if (_thread_pool) {
+        { stringstream t; t << "args_" << codegen_hash; args_struct = t.str(); }
+        ss << "typedef void (*chunk_func_t)(void *ctx, uint64_t begin, uint64_t end);\n";
+        ss << "typedef void (*parallel_for_t)(void *pool, uint64_t size, chunk_func_t func, void *ctx);\n\n";
+
+        ss << "struct " << args_struct << " {\n";
+        for(const bh_base* b: util::vector_cat(symbols.getParams(), kernel_temps)) {
+            util::spaces(ss, 4);
+            ss << writeType(b->type) << " *a" << symbols.baseID(b) << ";\n";
+        }
+        for (const bh_view *view: symbols.offsetStrideViews()) {
+            util::spaces(ss, 4);
+            ss << writeType(bh_type::UINT64) << " vo" << symbols.offsetStridesID(*view) << ";\n";
+            for (int i = 0; i < view->ndim; ++i) {
+                util::spaces(ss, 4);
+                ss << writeType(bh_type::UINT64) << " vs" << symbols.offsetStridesID(*view) << "_" << i << ";\n";
+            }
+        }
+        for (const jitk::InstrPtr &instr: symbols.constIDs()) {
+            util::spaces(ss, 4);
+            ss << writeType(instr->constant.type) << " c" << symbols.constID(*instr) << ";\n";
+        }
+        ss << "};\n\n";
+
+        for(size_t i = 0; i < block_list.size(); ++i) {
+            if (thread_pool_compatible(block_list[i].getLoop())) {
+                stringstream func_name;
+                func_name << "chunk_" << codegen_hash << "_" << i;
+                writeChunkFunction(symbols, block_list[i].getLoop(), func_name.str(), args_struct, ss);
+            }
+        }
+    }
+
+    // Besides the regular kernel arguments, the execute function might need the number of repeats and the pool
+    string extra_params;
+    if (repeat.enabled()) {
+        extra_params += writeType(bh_type::UINT64) + " nrepeats, ";
+    }
+    if (_thread_pool) {
+        extra_params += "parallel_for_t parallel_for, void *pool, ";
+    }
+
     // Write the header of the execute function
     ss << "void execute_" << codegen_hash;
-    writeKernelFunctionArguments(symbols, ss, nullptr);
+    if (not extra_params.empty()) {
+        stringstream args;
+        writeKernelFunctionArguments(symbols, args, nullptr);
+        string args_str = args.str();
+        args_str.pop_back(); // Remove the closing parenthesis
+        ss << args_str << (args_str.size() > 1 ? ", " : "") << extra_params.substr(0, extra_params.size()-2) << ")";
+    } else {
+        writeKernelFunctionArguments(symbols, ss, nullptr);
+    }
 
     // Write the block that makes up the body of 'execute()'
     ss << "{\n";
-    // Write allocations of the kernel temporaries
-    for(const bh_base* b: kernel_temps) {
+    // Write allocations of the kernel temporaries. Temporaries that share a buffer cannot be restrict pointers.
+    const vector<size_t> buffers = kernelTempBuffers(block_list, kernel_temps, repeat);
+    map<size_t, size_t> buffer_users;
+    for (size_t buffer: buffers) {
+        ++buffer_users[buffer];
+    }
+    for(size_t i = 0; i < kernel_temps.size(); ++i) {
+        const bh_base* b = kernel_temps[i];
         util::spaces(ss, 4);
-        ss << writeType(b->type) << " * __restrict__ a" << symbols.baseID(b) << " = malloc(" << bh_base_size(b)
-           << ");\n";
+        if (buffer_users.at(buffers[i]) == 1) {
+            ss << writeType(b->type) << " * __restrict__ a" << symbols.baseID(b) << " = malloc(" << bh_base_size(b)
+               << ");\n";
+        } else {
+            if (std::find(buffers.begin(), buffers.end(), buffers[i]) - buffers.begin() == (int64_t) i) {
+                ss << "void *buf" << buffers[i] << " = malloc(" << bh_base_size(b) << ");\n";
+                util::spaces(ss, 4);
+            }
+            ss << writeType(b->type) << " *a" << symbols.baseID(b) << " = buf" << buffers[i] << ";\n";
+        }
     }
     ss << "\n";
 
-    for(const jitk::Block &block: block_list) {
-        writeLoopBlock(symbols, nullptr, block.getLoop(), {}, false, ss);
+    if (_thread_pool) {
+        // Pack the arguments of the chunk functions
+        util::spaces(ss, 4);
+        ss << "struct " << args_struct << " args = {";
+        for(const bh_base* b: util::vector_cat(symbols.getParams(), kernel_temps)) {
+            ss << ".a" << symbols.baseID(b) << " = a" << symbols.baseID(b) << ", ";
+        }
+        for (const bh_view *view: symbols.offsetStrideViews()) {
+            const size_t id = symbols.offsetStridesID(*view);
+            ss << ".vo" << id << " = vo" << id << ", ";
+            for (int i = 0; i < view->ndim; ++i) {
+                ss << ".vs" << id << "_" << i << " = vs" << id << "_" << i << ", ";
+            }
+        }
+        for (const jitk::InstrPtr &instr: symbols.constIDs()) {
+            ss << ".c" << symbols.constID(*instr) << " = c" << symbols.constID(*instr) << ", ";
+        }
+        ss << "};\n";
+        util::spaces(ss, 4);
+        ss << "(void) args;\n";
+    }
+
+    // With temporal blocking, the repeats run 'nsteps' at a time as one wavefront sweep over the outermost axis
+    // and the remaining repeats run as a regular repeat loop
+    if (repeat.nsteps > 1) {
+        const int64_t max_shift = *std::max_element(repeat.shifts.begin(), repeat.shifts.end());
+        // The computing loops all sweep the same outermost axis, but the block list might start with a system block
+        uint64_t wavefront_size = 0;
+        for (const jitk::Block &block: block_list) {
+            if (not block.isInstr() and not block.isSystemOnly()) {
+                wavefront_size = block.getLoop().size;
+                break;
+            }
+        }
+        util::spaces(ss, 4);
+        ss << "uint64_t repeat = 0;\n";
+        util::spaces(ss, 4);
+        ss << "for(; repeat + " << repeat.nsteps << " <= nrepeats; repeat += " << repeat.nsteps << ") {\n";
+        util::spaces(ss, 4);
+        ss << "for(uint64_t wavefront = 0; wavefront < " << wavefront_size + max_shift
+           << "; ++wavefront) {\n";
+        for(size_t q = 0; q < repeat.shifts.size(); ++q) {
+            if (repeat.shifts[q] >= 0) {
+                _wavefront_shift = repeat.shifts[q];
+                writeOutermostLoop(symbols, block_list[q % block_list.size()].getLoop(), ss);
+            }
+        }
+        _wavefront_shift = -1;
+        util::spaces(ss, 4);
+        ss << "}\n";
+        util::spaces(ss, 4);
+        ss << "}\n";
+        util::spaces(ss, 4);
+        ss << "for(; repeat < nrepeats; ++repeat) {\n";
+    } else if (repeat.enabled()) {
+        // The repeat loop runs all the blocks repeatedly and checks the repeat condition after each iteration
+        util::spaces(ss, 4);
+        ss << "for(uint64_t repeat = 0; repeat < nrepeats; ++repeat) {\n";
+    }
+
+    for(size_t i = 0; i < block_list.size(); ++i) {
+        const jitk::LoopB &block = block_list[i].getLoop();
+        if (_thread_pool and thread_pool_compatible(block)) {
+            util::spaces(ss, 4);
+            ss << "parallel_for(pool, " << block.size << ", chunk_" << codegen_hash << "_" << i << ", &args);\n";
+        } else {
+            writeOutermostLoop(symbols, block, ss);
+        }
+    }
+
+    if (repeat.enabled()) {
+        if (repeat.condition != nullptr) {
+            util::spaces(ss, 8);
+            ss << "if (!a" << symbols.baseID(repeat.condition) << "[0]) {\n";
+            util::spaces(ss, 12);
+            ss << "break;\n";
+            util::spaces(ss, 8);
+            ss << "}\n";
+        }
+        util::spaces(ss, 4);
+        ss << "}\n";
     }
 
     // Write frees of the kernel temporaries
     ss << "\n";
-    for(const bh_base* b: kernel_temps) {
-        util::spaces(ss, 4);
-        ss << "free(" << "a" << symbols.baseID(b) << ");\n";
+    for(size_t i = 0; i < kernel_temps.size(); ++i) {
+        if (buffer_users.at(buffers[i]) == 1) {
+            util::spaces(ss, 4);
+            ss << "free(" << "a" << symbols.baseID(kernel_temps[i]) << ");\n";
+        } else if (std::find(buffers.begin(), buffers.end(), buffers[i]) - buffers.begin() == (int64_t) i) {
+            util::spaces(ss, 4);
+            ss << "free(buf" << buffers[i] << ");\n";
+        }
     }
     ss << "}\n\n";
 
@@ -354,7 +707,11 @@ void EngineOpenMP::writeKernel(const std::vector<jitk::Block> &block_list,
     // to typed arrays and call the execute function
     {
         ss << "void launcher_" << codegen_hash
-           << "(void* data_list[], uint64_t offset_strides[], union dtype constants[]) {\n";
+           << "(void* data_list[], uint64_t offset_strides[], union dtype constants[]";
+        if (_thread_pool) {
+            ss << ", parallel_for_t parallel_for, void *pool";
+        }
+        ss << ") {\n";
         for(size_t i = 0; i < symbols.getParams().size(); ++i) {
             util::spaces(ss, 4);
             bh_base *b = symbols.getParams()[i];
@@ -388,6 +745,15 @@ void EngineOpenMP::writeKernel(const std::vector<jitk::Block> &block_list,
             }
         }
 
+        // The number of repeats is the constant following the regular constants
+        if (repeat.enabled()) {
+            stmp << "constants[" << symbols.constIDs().size() << "]." << bh_type_text(bh_type::UINT64) << ", ";
+        }
+
+        if (_thread_pool) {
+            stmp << "parallel_for, pool, ";
+        }
+
         // And then we write `stmp` into `ss` excluding the last comma
         const string strtmp = stmp.str();
         if (not strtmp.empty()) {
@@ -398,12 +764,57 @@ void EngineOpenMP::writeKernel(const std::vector<jitk::Block> &block_list,
     }
 }
 
+void EngineOpenMP::writeChunkFunction(const jitk::SymbolTable &symbols,
+                                      const jitk::LoopB &block,
+                                      const std::string &func_name,
+                                      const std::string &args_struct,
+                                      std::stringstream &ss) {
+    ss << "static void " << func_name << "(void *ctx, uint64_t chunk_begin, uint64_t chunk_end) {\n";
+    util::spaces(ss, 4);
+    ss << "const struct " << args_struct << " *args = ctx;\n";
+
+    // Unpack the arguments, which makes the body of the chunk identical to the regular kernel body
+    // NB: we order the arrays by ID to make the source identical between executions
+    const set<bh_base*> non_temps = block.getAllNonTemps();
+    vector<const bh_base*> arrays(non_temps.begin(), non_temps.end());
+    std::sort(arrays.begin(), arrays.end(), [&](const bh_base *a, const bh_base *b) {
+        return symbols.baseID(a) < symbols.baseID(b);
+    });
+    for(const bh_base* b: arrays) {
+        util::spaces(ss, 4);
+        ss << writeType(b->type) << " * __restrict__ a" << symbols.baseID(b) << " = args->a" << symbols.baseID(b)
+           << ";\n";
+    }
+    for (const bh_view *view: symbols.offsetStrideViews()) {
+        const size_t id = symbols.offsetStridesID(*view);
+        util::spaces(ss, 4);
+        ss << "const " << writeType(bh_type::UINT64) << " vo" << id << " = args->vo" << id << ";\n";
+        for (int i = 0; i < view->ndim; ++i) {
+            util::spaces(ss, 4);
+            ss << "const " << writeType(bh_type::UINT64) << " vs" << id << "_" << i << " = args->vs" << id << "_" << i
+               << ";\n";
+        }
+    }
+    for (const jitk::InstrPtr &instr: symbols.constIDs()) {
+        util::spaces(ss, 4);
+        ss << "const " << writeType(instr->constant.type) << " c" << symbols.constID(*instr)
+           << " = args->c" << symbols.constID(*instr) << ";\n";
+    }
+    ss << "\n";
+    writeOutermostLoop(symbols, block, ss);
+    ss << "}\n\n";
+}
+
 std::string EngineOpenMP::info() const {
     stringstream ss;
     ss << "----"                                                           << "\n";
     ss << "OpenMP:"                                                        << "\n";
     ss << "  Hardware threads: " << std::thread::hardware_concurrency()    << "\n";
     ss << "  JIT Command: \"" << compiler.cmd_template << "\"\n";
+    if (_thread_pool) {
+        ss << "  Thread pool: " << _thread_pool->size() << " threads"
+           << (_thread_pool->pinned() ? " (pinned)" : "") << "\n";
+    }
     return ss.str();
 }
 
@@ -424,6 +835,8 @@ const std::string EngineOpenMP::writeType(bh_type dtype) {
         case bh_type::COMPLEX64:  return "float complex";
         case bh_type::COMPLEX128: return "double complex";
         case bh_type::R123:       return "r123_t"; // Defined by `write_c99_dtype_union()`
+        case bh_type::FLOAT16:    return "uint16_t"; // Converted by `kernel_dependencies/float16.h`
+        case bh_type::BFLOAT16:   return "uint16_t";
         default:
             std::cerr << "Unknown C99 type: " << bh_type_text(dtype) << std::endl;
             throw std::runtime_error("Unknown C99 type");
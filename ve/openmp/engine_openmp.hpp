@@ -23,6 +23,7 @@ If not, see <http://www.gnu.org/licenses/>.
 #include <iostream>
 #include <string>
 #include <map>
+#include <memory>
 #include <boost/filesystem.hpp>
 
 #include <bh_config_parser.hpp>
@@ -35,18 +36,38 @@ If not, see <http://www.gnu.org/licenses/>.
 
 #include <jitk/engines/engine_cpu.hpp>
 
+#include "thread_pool.hpp"
+
 namespace bohrium {
 
 typedef void (*KernelFunction)(void* data_list[], uint64_t offset_strides[], bh_constant_value constants[]);
 
+// The kernel function when using the thread pool, which takes the parallel for-loop function and the pool as arguments
+typedef void (*PoolKernelFunction)(void* data_list[], uint64_t offset_strides[], bh_constant_value constants[],
+                                   ThreadPool::ParallelFor parallel_for, void *pool);
+
 class EngineOpenMP : public jitk::EngineCPU {
 private:
     std::map<uint64_t, KernelFunction> _functions;
     std::vector<void*> _lib_handles;
 
+    // The accuracy policy of the math functions, which is "off", "ulp", or "fast" (see `fast_math` in the config)
+    const std::string fast_math;
+
     // The compiler to use when function doesn't exist
     const jitk::Compiler compiler;
 
+    // When not NULL, the kernels run on this thread pool instead of using "omp parallel for"
+    std::unique_ptr<ThreadPool> _thread_pool;
+
+    // When writing a temporal blocking wavefront, the shift of the current loop block (otherwise -1)
+    int64_t _wavefront_shift = -1;
+
+    // When writing an outermost loop that streams outputs, whether the loop must fence the streamed stores and whether
+    // its header opened a parallel region, which the fence must close
+    bool _stream_fence = false;
+    bool _stream_fence_region = false;
+
     // Return a kernel function based on the given 'source' and the name of the kernel function
     KernelFunction getFunction(const std::string &source, const std::string &func_name);
 
@@ -59,13 +80,15 @@ public:
                  uint64_t codegen_hash,
                  const std::vector<bh_base*> &non_temps,
                  const std::vector<const bh_view*> &offset_strides,
-                 const std::vector<const bh_instruction*> &constants) override;
+                 const std::vector<const bh_instruction*> &constants,
+                 const jitk::KernelRepeat &repeat) override;
 
     void setConstructorFlag(std::vector<bh_instruction*> &instr_list) override;
 
     void writeKernel(const std::vector<jitk::Block> &block_list,
                      const jitk::SymbolTable &symbols,
                      const std::vector<bh_base*> &kernel_temps,
+                     const jitk::KernelRepeat &repeat,
                      uint64_t codegen_hash,
                      std::stringstream &ss) override;
 
@@ -82,6 +105,30 @@ public:
                         const std::vector<uint64_t> &thread_stack,
                         std::stringstream &out) override;
 
+    void loopTailWriter(const jitk::SymbolTable &symbols,
+                        const jitk::Scope &scope,
+                        const jitk::LoopB &block,
+                        std::stringstream &out) override;
+
+    // Writes the header of an innermost loop that writes its streamed outputs with non-temporal stores
+    void writeStreamingLoopHead(const jitk::SymbolTable &symbols,
+                                jitk::Scope &scope,
+                                const jitk::LoopB &block,
+                                std::stringstream &out);
+
+    // Writes an outermost loop, which fences its streamed stores after the iterations of each thread
+    void writeOutermostLoop(const jitk::SymbolTable &symbols, const jitk::LoopB &block, std::stringstream &out);
+
+    // Opens the parallel region of an outermost loop that fences its streamed stores
+    void openStreamFenceRegion(std::stringstream &out);
+
+    // Write the body of a parallel for-loop, which the thread pool calls with a chunk of the outermost loop
+    void writeChunkFunction(const jitk::SymbolTable &symbols,
+                            const jitk::LoopB &block,
+                            const std::string &func_name,
+                            const std::string &args_struct,
+                            std::stringstream &ss);
+
     // Return a YAML string describing this component
     std::string info() const override;
 
@@ -107,6 +154,8 @@ private:
         util::spaces(out, 4); out << writeType(bh_type::COMPLEX64)  << " " << bh_type_text(bh_type::COMPLEX64)  << ";\n";
         util::spaces(out, 4); out << writeType(bh_type::COMPLEX128) << " " << bh_type_text(bh_type::COMPLEX128) << ";\n";
         util::spaces(out, 4); out << writeType(bh_type::R123)       << " " << bh_type_text(bh_type::R123)       << ";\n";
+        util::spaces(out, 4); out << writeType(bh_type::FLOAT16)    << " " << bh_type_text(bh_type::FLOAT16)    << ";\n";
+        util::spaces(out, 4); out << writeType(bh_type::BFLOAT16)   << " " << bh_type_text(bh_type::BFLOAT16)   << ";\n";
         out << "};\n";
     }
 };
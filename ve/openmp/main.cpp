@@ -36,6 +36,7 @@ If not, see <http://www.gnu.org/licenses/>.
 #include <jitk/statistics.hpp>
 #include <jitk/dtype.hpp>
 #include <jitk/apply_fusion.hpp>
+#include <jitk/loop_invariant.hpp>
 
 #include "engine_openmp.hpp"
 
@@ -63,6 +64,8 @@ class Impl : public ComponentImpl {
                             engine(config, stat) {}
     ~Impl();
     void execute(BhIR *bhir);
+    // Execute all the repeats of 'bhir'
+    void executeRepeats(BhIR *bhir);
     void extmethod(const string &name, bh_opcode opcode) {
         // ExtmethodFace does not have a default or copy constructor thus
         // we have to use its move constructor.
@@ -88,6 +91,8 @@ class Impl : public ComponentImpl {
         if (not copy2host) {
             throw runtime_error("OpenMP - getMemoryPointer(): `copy2host` is not True");
         }
+        // The bit-packed storage is private to the kernels
+        bh_data_unpack(&base);
         if (force_alloc) {
             bh_data_malloc(&base);
         }
@@ -106,6 +111,7 @@ class Impl : public ComponentImpl {
         if (base->data != nullptr) {
             throw runtime_error("OpenMP - setMemoryPointer(): `base->data` is not NULL");
         }
+        base->packed = false;
         base->data = mem;
     }
 
@@ -133,13 +139,50 @@ Impl::~Impl() {
 }
 
 void Impl::execute(BhIR *bhir) {
+    // Let's move the loop-invariant instructions out of the repeats
+    if (bhir->getNRepeats() > 1 and config.defaultGet<bool>("hoist_loop_invariants", true)) {
+        vector<bh_instruction> prologue, epilogue;
+        const uint64_t work = hoist_loop_invariants(*bhir, prologue, epilogue);
+        if (not prologue.empty()) {
+            stat.num_hoisted_instrs += prologue.size();
+            stat.hoisted_work += work * (bhir->getNRepeats() - 1);
+            BhIR prologue_bhir(std::move(prologue), {});
+            executeRepeats(&prologue_bhir);
+            executeRepeats(bhir);
+            BhIR epilogue_bhir(std::move(epilogue), {});
+            executeRepeats(&epilogue_bhir);
+            return;
+        }
+    }
+    executeRepeats(bhir);
+}
+
+void Impl::executeRepeats(BhIR *bhir) {
+    // When there are no extension methods, all the repeats run within one kernel call
+    if (bhir->getNRepeats() > 1 and config.defaultGet<bool>("repeat_in_kernel", true)) {
+        bool has_extmethods = false;
+        for (const bh_instruction &instr: bhir->instr_list) {
+            if (util::exist(extmethods, instr.opcode)) {
+                has_extmethods = true;
+                break;
+            }
+        }
+        if (not has_extmethods) {
+            engine.handleExecution(bhir, true);
+            return;
+        }
+    }
+
     bh_base *cond = bhir->getRepeatCondition();
     for (uint64_t i = 0; i < bhir->getNRepeats(); ++i) {
+        // NB: handling the extension methods consumes the instructions, thus each repeat gets its own copy
+        BhIR iteration(bhir->instr_list, bhir->getSyncs());
+
         // Let's handle extension methods
-        engine.handleExtmethod(*this, bhir);
+        engine.handleExtmethod(*this, &iteration);
 
         // And then the regular instructions
-        engine.handleExecution(bhir);
+        engine.handleExecution(&iteration);
 
         // Check condition
         if (cond != nullptr and cond->data != nullptr and not ((bool*) cond->data)[0]) {
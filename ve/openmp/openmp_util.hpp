@@ -70,10 +70,12 @@ bool simd_compatible(const bohrium::jitk::LoopB &block,
             return false;
     }
 
-    // An OpenMP SIMD loop does not support ANY OpenMP pragmas
+    // An OpenMP SIMD loop does not support ANY OpenMP pragmas nor the atomic writes of bit-packed arrays
+    // nor the rotation of sliding windows, which carries values between iterations
     for (bohrium::jitk::InstrPtr instr: block.getAllInstr()) {
         for(const bh_view *view: instr->get_views()) {
-            if (scope.isOpenmpAtomic(*view) or scope.isOpenmpCritical(*view))
+            if (scope.isOpenmpAtomic(*view) or scope.isOpenmpCritical(*view) or view->base->packed or
+                scope.isSlidingWindow(*view))
                 return false;
         }
     }
@@ -93,3 +95,8 @@ bool openmp_atomic_compatible(bh_opcode opcode) {
             return false;
     }
 }
+
+// Is the 'block' compatible with the thread pool, which requires independent iterations of the outermost loop
+bool thread_pool_compatible(const bohrium::jitk::LoopB &block) {
+    return block.rank == 0 and block.size > 1 and block._sweeps.empty() and not block.isSystemOnly();
+}
@@ -0,0 +1,177 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "thread_pool.hpp"
+
+using namespace std;
+
+namespace bohrium {
+
+namespace {
+// Return the number of hardware threads (at least one)
+uint64_t hardware_threads() {
+    const unsigned int ret = std::thread::hardware_concurrency();
+    return ret == 0 ? 1 : ret;
+}
+
+// Pin 'thread' to the core 'core_id' and returns false when it fails
+bool pin_thread(std::thread &thread, uint64_t core_id) {
+#ifdef __linux__
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(core_id % hardware_threads(), &cpuset);
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuset) == 0;
+#else
+    return true;
+#endif
+}
+}
+
+ThreadPool::ThreadPool(uint64_t num_threads, bool pinning, uint64_t chunks_per_thread) :
+    _num_threads(num_threads == 0 ? hardware_threads() : num_threads),
+    _pinning(pinning),
+    _chunks_per_thread(std::max(chunks_per_thread, (uint64_t) 1)) {
+
+    for (uint64_t i = 0; i < _num_threads; ++i) {
+        _queues.emplace_back(new Queue());
+    }
+    // NB: the calling thread is thread zero, which we leave unpinned
+    uint64_t unpinned = 0;
+    for (uint64_t i = 1; i < _num_threads; ++i) {
+        _workers.emplace_back(&ThreadPool::workerLoop, this, i);
+        if (_pinning and not pin_thread(_workers.back(), i)) {
+            ++unpinned;
+        }
+    }
+    if (unpinned > 0) {
+        cerr << "[ThreadPool] Warning: couldn't pin " << unpinned << " of " << _num_threads - 1
+             << " threads to cores" << endl;
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        unique_lock<mutex> lock(_mutex);
+        _shutdown = true;
+    }
+    _wakeup.notify_all();
+    for (std::thread &worker: _workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(uint64_t size, ChunkFunction func, void *ctx) {
+    if (size == 0) {
+        return;
+    }
+    const uint64_t num_chunks = std::min(size, _num_threads * _chunks_per_thread);
+    if (num_chunks == 1 or _workers.empty()) {
+        func(ctx, 0, size);
+        return;
+    }
+
+    // Distribute consecutive chunks to each thread, which preserves locality until the threads start stealing
+    _remaining = num_chunks;
+    const uint64_t chunks_per_queue = (num_chunks + _num_threads - 1) / _num_threads;
+    for (uint64_t c = 0; c < num_chunks; ++c) {
+        Queue &queue = *_queues[c / chunks_per_queue];
+        const uint64_t begin = size * c / num_chunks;
+        const uint64_t end = size * (c + 1) / num_chunks;
+        unique_lock<mutex> lock(queue.mutex);
+        queue.chunks.push_back({begin, end, func, ctx});
+    }
+    {
+        unique_lock<mutex> lock(_mutex);
+        ++_generation;
+    }
+    _wakeup.notify_all();
+
+    // The calling thread participates as thread zero
+    runChunks(0);
+
+    // And then waits for the chunks stolen by the workers
+    unique_lock<mutex> lock(_mutex);
+    _finished.wait(lock, [this]{ return _remaining == 0; });
+}
+
+void ThreadPool::parallelForTrampoline(void *pool, uint64_t size, ChunkFunction func, void *ctx) {
+    assert(pool != nullptr);
+    static_cast<ThreadPool *>(pool)->parallelFor(size, func, ctx);
+}
+
+bool ThreadPool::pop(uint64_t thread_id, Chunk &chunk) {
+    // The owner takes chunks from the front of its own queue
+    {
+        Queue &queue = *_queues[thread_id];
+        unique_lock<mutex> lock(queue.mutex);
+        if (not queue.chunks.empty()) {
+            chunk = queue.chunks.front();
+            queue.chunks.pop_front();
+            return true;
+        }
+    }
+    // Thieves take chunks from the back of the other queues
+    for (uint64_t i = 1; i < _num_threads; ++i) {
+        Queue &queue = *_queues[(thread_id + i) % _num_threads];
+        unique_lock<mutex> lock(queue.mutex);
+        if (not queue.chunks.empty()) {
+            chunk = queue.chunks.back();
+            queue.chunks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::runChunks(uint64_t thread_id) {
+    Chunk chunk;
+    while (pop(thread_id, chunk)) {
+        chunk.func(chunk.ctx, chunk.begin, chunk.end);
+        if (--_remaining == 0) {
+            unique_lock<mutex> lock(_mutex);
+            _finished.notify_all();
+        }
+    }
+}
+
+void ThreadPool::workerLoop(uint64_t thread_id) {
+    uint64_t generation = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lock(_mutex);
+            _wakeup.wait(lock, [&]{ return _shutdown or _generation != generation; });
+            if (_shutdown) {
+                return;
+            }
+            generation = _generation;
+        }
+        runChunks(thread_id);
+    }
+}
+
+} // bohrium
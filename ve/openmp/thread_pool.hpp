@@ -0,0 +1,102 @@
+/*
+This file is part of Bohrium and copyright (c) 2012 the Bohrium
+team <http://www.bh107.org>.
+
+Bohrium is free software: you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as
+published by the Free Software Foundation, either version 3
+of the License, or (at your option) any later version.
+
+Bohrium is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the
+GNU Lesser General Public License along with Bohrium.
+
+If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+namespace bohrium {
+
+// A persistent pool of (optionally pinned) threads that executes parallel for-loops.
+// The iteration space is split into chunks and each thread owns a queue of chunks.
+// When a thread runs out of chunks, it steals from the other queues.
+class ThreadPool {
+public:
+    // The body of a parallel for-loop, which executes the iterations [begin, end) using the arguments in 'ctx'
+    typedef void (*ChunkFunction)(void *ctx, uint64_t begin, uint64_t end);
+
+    // The C compatible parallel for-loop function that the JIT-kernels call
+    typedef void (*ParallelFor)(void *pool, uint64_t size, ChunkFunction func, void *ctx);
+
+    // Create a pool of 'num_threads' threads (incl. the calling thread).
+    // 'num_threads' == 0 means the number of hardware threads.
+    ThreadPool(uint64_t num_threads, bool pinning, uint64_t chunks_per_thread);
+    ~ThreadPool();
+
+    // No copy or move constructor!
+    ThreadPool(const ThreadPool &other) = delete;
+    ThreadPool(ThreadPool &&other) = delete;
+
+    // Number of threads in the pool (incl. the calling thread)
+    uint64_t size() const { return _num_threads; }
+
+    // Is the threads pinned to cores?
+    bool pinned() const { return _pinning; }
+
+    // Execute 'func' on the iterations [0, size) and return when all iterations are done
+    void parallelFor(uint64_t size, ChunkFunction func, void *ctx);
+
+    // Calls `parallelFor()` on 'pool', which must point to a ThreadPool
+    static void parallelForTrampoline(void *pool, uint64_t size, ChunkFunction func, void *ctx);
+
+private:
+    struct Chunk {
+        uint64_t begin, end;
+        ChunkFunction func;
+        void *ctx;
+    };
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;
+    };
+
+    const uint64_t _num_threads;
+    const bool _pinning;
+    const uint64_t _chunks_per_thread;
+
+    // The worker threads, the calling thread is thread zero thus it isn't in this list
+    std::vector<std::thread> _workers;
+    // The chunk queue of each thread (incl. the calling thread)
+    std::vector<std::unique_ptr<Queue> > _queues;
+
+    // Synchronization between the calling thread and the workers
+    std::mutex _mutex;
+    std::condition_variable _wakeup;
+    std::condition_variable _finished;
+    uint64_t _generation = 0;
+    bool _shutdown = false;
+    std::atomic<uint64_t> _remaining{0};
+
+    // Pop a chunk from the queue of 'thread_id' or steal one from another queue
+    bool pop(uint64_t thread_id, Chunk &chunk);
+
+    // Execute chunks until all queues are empty
+    void runChunks(uint64_t thread_id);
+
+    // The main loop of the worker threads
+    void workerLoop(uint64_t thread_id);
+};
+
+} // bohrium